@@ -0,0 +1,466 @@
+//
+// Created by JanHe on 16.10.2026.
+//
+
+#include "BaudNegotiator.h"
+
+#include <Preferences.h>
+
+#include "Guardian.h"
+#include "MeterRegisters.h"
+#include "PinOut.h"
+#include "RegisterCodec.h"
+
+// Baud Rates by Index of the BAUD_RATE Register.
+constexpr uint32_t BAUD_RATES[] = {2400, 4800, 9600, 19200, 38400};
+
+constexpr uint8_t BAUD_RATE_COUNT = sizeof(BAUD_RATES) / sizeof(uint32_t);
+
+static_assert(MODBUS_BAUD_MAX < BAUD_RATE_COUNT, "MODBUS_BAUD_MAX must be a valid Baud Rate Index");
+
+// Other Devices on the Bus can't follow a Rate Change, so the Rate is only probed.
+constexpr bool BAUD_SHARED = METER_DEVICE_COUNT > 1;
+
+// Store RTU Client and Serial.
+ModbusClientRTU* negotiatorClient = nullptr;
+HardwareSerial* negotiatorSerial = nullptr;
+
+// Store NVS Instance.
+Preferences baudPreferences;
+
+// Store Negotiation State.
+BaudNegotiator::State baudState = BaudNegotiator::PROBE;
+
+// Store current, previous and highest allowed Baud Rate Index.
+uint8_t baudIndex = 0;
+uint8_t baudPrevious = 0;
+uint8_t baudLimit = MODBUS_BAUD_MAX;
+
+// Store failed Attempts, verified Reads and already scanned Rates (Bitmask).
+uint8_t baudAttempts = 0;
+uint8_t baudVerified = 0;
+uint8_t baudScanned = 0;
+
+// Store pending Request and its Result (written by the RTU Client Task).
+bool baudWaiting = false;
+BaudNegotiator::Result baudResult = BaudNegotiator::NONE;
+
+// Store CRC Errors of the current Minute.
+uint8_t baudCrcErrors = 0;
+unsigned long baudCrcWindow = 0;
+
+portMUX_TYPE baudMux = portMUX_INITIALIZER_UNLOCKED;
+
+
+/**
+ * @brief Loads the last negotiated baud rate from the NVS.
+ *
+ * Must be called before the serial is started, so it is started with getBaudRate().
+ *
+ * @param client The RTU client of the local meter.
+ * @param serial The serial used by the RTU client.
+ */
+void BaudNegotiator::begin(ModbusClientRTU* client, HardwareSerial* serial)
+{
+    negotiatorClient = client;
+    negotiatorSerial = serial;
+
+    baudPreferences.begin("modbus", true);
+    baudIndex = baudPreferences.getUChar("baud", indexOf(MODBUS_BAUD));
+    baudPreferences.end();
+
+    // Ignore invalid stored Values.
+    if (baudIndex > MODBUS_BAUD_MAX)
+        baudIndex = indexOf(MODBUS_BAUD);
+
+    baudState = PROBE;
+}
+
+/**
+ * @brief Advances the negotiation, should be called from the loop.
+ *
+ * New requests are only sent while no regular request is in flight, because the
+ * rate of both ends may change afterward.
+ *
+ * @param idle true if no regular request of the RTU client is in flight.
+ */
+void BaudNegotiator::loop(bool idle)
+{
+    if (baudState == DONE)
+    {
+        handleMonitor();
+
+        if (baudState == DONE)
+            return;
+    }
+
+    if (baudWaiting)
+    {
+        portENTER_CRITICAL(&baudMux);
+        Result result = baudResult;
+        portEXIT_CRITICAL(&baudMux);
+
+        // Wait for Response or Timeout.
+        if (result == NONE)
+            return;
+
+        baudWaiting = false;
+
+        switch (baudState)
+        {
+        case PROBE:
+            handleProbe(result == OK);
+            break;
+        case UPGRADE:
+            handleUpgrade(result == OK);
+            break;
+        case VERIFY:
+            handleVerify(result == OK);
+            break;
+        case DOWNGRADE:
+            handleDowngrade();
+            break;
+        default:
+            break;
+        }
+
+        return;
+    }
+
+    // Wait for regular Requests to finish.
+    if (!idle)
+        return;
+
+    switch (baudState)
+    {
+    case PROBE:
+    case VERIFY:
+        sendRead();
+        break;
+    case UPGRADE:
+        sendWrite(baudIndex + 1);
+        break;
+    case DOWNGRADE:
+        sendWrite(baudPrevious);
+        break;
+    default:
+        break;
+    }
+}
+
+/**
+ * @brief Checks if the negotiation owns the bus.
+ *
+ * @return true if regular requests must be held back.
+ */
+bool BaudNegotiator::isBusy()
+{
+    return baudState != DONE;
+}
+
+/**
+ * @brief Checks if a token belongs to a negotiation request.
+ *
+ * @param token The token of the request.
+ *
+ * @return true if the response must be handed to the negotiator.
+ */
+bool BaudNegotiator::isToken(uint32_t token)
+{
+    return (token & BAUD_TOKEN) != 0;
+}
+
+/**
+ * @brief Handles the response of a negotiation request (RTU client task).
+ *
+ * @param msg The response message.
+ */
+void BaudNegotiator::handleData(const ModbusMessage& msg)
+{
+    portENTER_CRITICAL(&baudMux);
+    baudResult = OK;
+    portEXIT_CRITICAL(&baudMux);
+}
+
+/**
+ * @brief Handles the failure of a negotiation request (RTU client task).
+ *
+ * @param error The error reported by the client.
+ */
+void BaudNegotiator::handleError(Error error)
+{
+    portENTER_CRITICAL(&baudMux);
+    baudResult = FAILED;
+    portEXIT_CRITICAL(&baudMux);
+}
+
+/**
+ * @brief Accounts a CRC error of a regular request (RTU client task).
+ */
+void BaudNegotiator::crcError()
+{
+    portENTER_CRITICAL(&baudMux);
+
+    if (baudCrcErrors < UINT8_MAX)
+        baudCrcErrors++;
+
+    portEXIT_CRITICAL(&baudMux);
+}
+
+/**
+ * @brief Retrieves the baud rate currently used on the RTU link.
+ *
+ * @return The baud rate.
+ */
+uint32_t BaudNegotiator::getBaudRate()
+{
+    return BAUD_RATES[baudIndex];
+}
+
+/**
+ * @brief Evaluates a probe read of the BAUD_RATE register.
+ *
+ * If the meter does not answer twice, the next untested rate (highest first) is
+ * tried, until the meter is found or all rates were scanned. With more than one
+ * device on the bus the found rate is kept.
+ *
+ * @param ok true if the meter answered.
+ */
+void BaudNegotiator::handleProbe(bool ok)
+{
+    if (ok)
+    {
+        baudAttempts = 0;
+        baudScanned = 0;
+
+        if (baudIndex < baudLimit && !BAUD_SHARED)
+        {
+            baudState = UPGRADE;
+        }
+        else
+        {
+            store();
+
+            baudState = DONE;
+        }
+
+        return;
+    }
+
+    if (++baudAttempts < 2)
+        return;
+
+    baudAttempts = 0;
+    baudScanned |= 1 << baudIndex;
+
+    // Scan next untested Rate.
+    for (int8_t i = MODBUS_BAUD_MAX; i >= 0; i--)
+    {
+        if ((baudScanned & (1 << i)) == 0)
+        {
+            switchRate(i);
+
+            return;
+        }
+    }
+
+    // Give up and keep polling at the default Rate.
+    Guardian::println("Meter Baud not found");
+
+    switchRate(indexOf(MODBUS_BAUD));
+
+    baudState = DONE;
+}
+
+/**
+ * @brief Evaluates the write of the next higher rate to the meter.
+ *
+ * The meter answers at the old rate, so both ends are switched afterward.
+ *
+ * @param ok true if the meter accepted the new rate.
+ */
+void BaudNegotiator::handleUpgrade(bool ok)
+{
+    if (!ok)
+    {
+        // Meter does not support the Rate (or the Register is write protected).
+        baudLimit = baudIndex;
+
+        store();
+
+        baudState = DONE;
+
+        return;
+    }
+
+    baudPrevious = baudIndex;
+    baudAttempts = 0;
+    baudVerified = 0;
+
+    switchRate(baudIndex + 1);
+
+    baudState = VERIFY;
+}
+
+/**
+ * @brief Evaluates a verification read at the new rate.
+ *
+ * After MODBUS_BAUD_VERIFY successful reads the rate is accepted and stored, two
+ * failed reads fall back to the previous rate.
+ *
+ * @param ok true if the meter answered.
+ */
+void BaudNegotiator::handleVerify(bool ok)
+{
+    if (ok)
+    {
+        if (++baudVerified < MODBUS_BAUD_VERIFY)
+            return;
+
+        Guardian::println(("Baud " + String(getBaudRate())).c_str());
+
+        store();
+
+        baudState = (baudIndex < baudLimit ? UPGRADE : DONE);
+
+        return;
+    }
+
+    if (++baudAttempts < 2)
+        return;
+
+    // Drop the Rate for this Boot.
+    baudLimit = baudPrevious;
+    baudState = DOWNGRADE;
+}
+
+/**
+ * @brief Switches both ends back to the previous rate.
+ *
+ * The previous rate is written to the meter before (best effort, it may not understand
+ * the unreliable rate). If the meter did not switch back, the following probe scans
+ * all rates to find it again.
+ */
+void BaudNegotiator::handleDowngrade()
+{
+    Guardian::println("Baud Fallback");
+
+    switchRate(baudPrevious);
+
+    baudAttempts = 0;
+    baudState = PROBE;
+}
+
+/**
+ * @brief Falls back to the next lower rate if too many CRC errors occur.
+ *
+ * Not used with more than one device on the bus, only the first one would follow.
+ */
+void BaudNegotiator::handleMonitor()
+{
+    unsigned long now = millis();
+
+    if (BAUD_SHARED)
+        return;
+
+    if (now - baudCrcWindow < 60000)
+        return;
+
+    portENTER_CRITICAL(&baudMux);
+    uint8_t errors = baudCrcErrors;
+    baudCrcErrors = 0;
+    portEXIT_CRITICAL(&baudMux);
+
+    baudCrcWindow = now;
+
+    if (errors >= MODBUS_BAUD_CRC_LIMIT && baudIndex > 0)
+    {
+        baudPrevious = baudIndex - 1;
+        baudLimit = baudPrevious;
+        baudState = DOWNGRADE;
+    }
+}
+
+/**
+ * @brief Reads the BAUD_RATE holding register of the first device.
+ */
+void BaudNegotiator::sendRead()
+{
+    baudResult = NONE;
+    baudWaiting = true;
+
+    Error error = negotiatorClient->addRequest(BAUD_TOKEN | baudState, METER_DEVICES[0].serverID,
+                                               READ_HOLD_REGISTER, BAUD_REGISTER.address, BAUD_REGISTER.words);
+
+    if (error != SUCCESS)
+        baudResult = FAILED;
+}
+
+/**
+ * @brief Writes a baud rate index to the BAUD_RATE holding register of the first device.
+ *
+ * @param index The index of the new rate (see BAUD_RATES).
+ */
+void BaudNegotiator::sendWrite(uint8_t index)
+{
+    uint8_t data[4];
+
+    RegisterCodec::encode(index, data, BAUD_REGISTER);
+
+    baudResult = NONE;
+    baudWaiting = true;
+
+    Error error = negotiatorClient->addRequest(BAUD_TOKEN | baudState, METER_DEVICES[0].serverID,
+                                               WRITE_MULT_REGISTERS, BAUD_REGISTER.address, BAUD_REGISTER.words,
+                                               sizeof(data), data);
+
+    if (error != SUCCESS)
+        baudResult = FAILED;
+}
+
+/**
+ * @brief Switches the local end of the RTU link to another rate.
+ *
+ * The RTU client is restarted, because it derives the inter-frame gap from the rate.
+ *
+ * @param index The index of the new rate (see BAUD_RATES).
+ */
+void BaudNegotiator::switchRate(uint8_t index)
+{
+    baudIndex = index;
+
+    negotiatorClient->end();
+    negotiatorSerial->updateBaudRate(BAUD_RATES[index]);
+    negotiatorClient->begin(*negotiatorSerial, MODBUS_CORE);
+}
+
+/**
+ * @brief Stores the current rate in the NVS (only if it changed).
+ */
+void BaudNegotiator::store()
+{
+    baudPreferences.begin("modbus", false);
+
+    if (baudPreferences.getUChar("baud", UINT8_MAX) != baudIndex)
+        baudPreferences.putUChar("baud", baudIndex);
+
+    baudPreferences.end();
+}
+
+/**
+ * @brief Finds the index of a baud rate.
+ *
+ * @param rate The baud rate.
+ *
+ * @return The index of the rate, or the index of 9600 if the rate is unknown.
+ */
+uint8_t BaudNegotiator::indexOf(uint32_t rate)
+{
+    for (uint8_t i = 0; i < BAUD_RATE_COUNT; i++)
+    {
+        if (BAUD_RATES[i] == rate)
+            return i;
+    }
+
+    return 2;
+}
@@ -0,0 +1,79 @@
+//
+// Created by JanHe on 16.10.2026.
+//
+
+#ifndef BAUDNEGOTIATOR_H
+#define BAUDNEGOTIATOR_H
+
+#include <Arduino.h>
+#include <HardwareSerial.h>
+
+#include "ModbusClientRTU.h"
+#include "ModbusMessage.h"
+
+// Token Flag of Negotiation Requests (never set by ReadPlanner Tokens).
+#define BAUD_TOKEN 0x80000000UL
+
+
+/**
+ * @class BaudNegotiator
+ * @brief Negotiates the highest reliable baud rate with the local meter.
+ *
+ * At boot the meter is probed at the last stored rate (or at all rates if it does not
+ * answer). Afterward the rate is raised step by step: the new rate is written to the
+ * BAUD_RATE holding register, both ends are switched and the link is verified with
+ * MODBUS_BAUD_VERIFY reads. A rate which fails verification, or which produces more
+ * than MODBUS_BAUD_CRC_LIMIT CRC errors per minute later on, is dropped and the next
+ * lower rate is used and stored in the NVS.
+ *
+ * Only the first device of METER_DEVICES is negotiated with. If further devices share
+ * the bus, the rate of the first device is only probed and never changed.
+ *
+ * Responses arrive in the Modbus client task, the state machine itself only runs in
+ * the loop, because the RTU client must not be restarted from its own task.
+ */
+class BaudNegotiator
+{
+public:
+    /**
+     * @enum State
+     * @brief The steps of the negotiation.
+     */
+    enum State
+    {
+        PROBE, UPGRADE, VERIFY, DOWNGRADE, DONE
+    };
+
+    /**
+     * @enum Result
+     * @brief The outcome of the pending request.
+     */
+    enum Result
+    {
+        NONE, OK, FAILED
+    };
+
+    static void begin(ModbusClientRTU* client, HardwareSerial* serial);
+    static void loop(bool idle);
+    static bool isBusy();
+    static bool isToken(uint32_t token);
+    static void handleData(const ModbusMessage& msg);
+    static void handleError(Error error);
+    static void crcError();
+    static uint32_t getBaudRate();
+
+private:
+    static void handleProbe(bool ok);
+    static void handleUpgrade(bool ok);
+    static void handleVerify(bool ok);
+    static void handleDowngrade();
+    static void handleMonitor();
+    static void sendRead();
+    static void sendWrite(uint8_t index);
+    static void switchRate(uint8_t index);
+    static void store();
+    static uint8_t indexOf(uint32_t rate);
+};
+
+
+#endif //BAUDNEGOTIATOR_H
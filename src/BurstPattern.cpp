@@ -0,0 +1,85 @@
+//
+// Created by JanHe on 16.10.2026.
+//
+
+#include "BurstPattern.h"
+
+/**
+ * @brief Constructs a burst pattern.
+ *
+ * @param length The count of mains cycles per packet.
+ * @param pattern The distribution of the on cycles.
+ */
+BurstPattern::BurstPattern(uint16_t length, Pattern pattern)
+{
+    this->length = max(length, static_cast<uint16_t>(1));
+    this->pattern = pattern;
+}
+
+/**
+ * @brief Sets the share of on cycles, taken over at the start of the next packet.
+ *
+ * @param target The share (0 to 1).
+ */
+void BurstPattern::setTarget(float target)
+{
+    this->target = constrain(target, 0.0F, 1.0F);
+}
+
+/**
+ * @brief Decides if the SCR fires in the next mains cycle.
+ *
+ * @return true to fire the whole cycle.
+ */
+bool BurstPattern::next()
+{
+    // Start a new Packet.
+    if (position == 0)
+    {
+        float wanted = target * length + residual;
+
+        on = static_cast<uint16_t>(constrain(lroundf(wanted), 0L, static_cast<long>(length)));
+        residual = constrain(wanted - on, -1.0F, 1.0F);
+    }
+
+    bool fire;
+
+    if (pattern == BLOCK)
+        fire = (position < on);
+    else
+        // Fire where the evenly spaced Line of on Cycles crosses the next whole Count.
+        fire = ((position + 1) * on / length) > (position * on / length);
+
+    position = (position + 1) % length;
+
+    return fire;
+}
+
+/**
+ * @brief Drops the residual and starts a new packet with the next cycle.
+ */
+void BurstPattern::reset()
+{
+    residual = 0;
+    position = 0;
+}
+
+/**
+ * @brief Retrieves the count of mains cycles per packet.
+ *
+ * @return The count of cycles.
+ */
+uint16_t BurstPattern::getLength() const
+{
+    return length;
+}
+
+/**
+ * @brief Retrieves the count of on cycles of the current packet.
+ *
+ * @return The count of cycles.
+ */
+uint16_t BurstPattern::getOnCycles() const
+{
+    return on;
+}
@@ -0,0 +1,51 @@
+//
+// Created by JanHe on 16.10.2026.
+//
+
+#ifndef BURSTPATTERN_H
+#define BURSTPATTERN_H
+
+#include <Arduino.h>
+
+
+/**
+ * @class BurstPattern
+ * @brief Schedules whole mains cycles of a burst fired heater.
+ *
+ * The output is split into packets of a fixed count of mains cycles. At the start of a
+ * packet the target is turned into a count of on cycles, the rounding residual is carried
+ * to the next packet, so the mean over several packets matches the target exactly. The
+ * on cycles are either spread evenly over the packet (Bresenham, least flicker) or
+ * fired as one block at its start (fewest switching events). The pattern has no IO, the
+ * caller asks next() once per mains cycle.
+ */
+class BurstPattern
+{
+public:
+    /**
+     * @enum Pattern
+     * @brief The distribution of the on cycles inside a packet.
+     */
+    enum Pattern
+    {
+        SPREAD, BLOCK
+    };
+
+    BurstPattern(uint16_t length, Pattern pattern);
+    void setTarget(float target);
+    bool next();
+    void reset();
+    uint16_t getLength() const;
+    uint16_t getOnCycles() const;
+
+private:
+    uint16_t length;
+    Pattern pattern;
+    float target = 0;
+    float residual = 0;
+    uint16_t position = 0;
+    uint16_t on = 0;
+};
+
+
+#endif //BURSTPATTERN_H
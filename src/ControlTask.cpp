@@ -0,0 +1,131 @@
+//
+// Created by JanHe on 16.10.2026.
+//
+
+#include "ControlTask.h"
+
+#include "Guardian.h"
+#include "PinOut.h"
+
+// Store Step Function of the Task.
+void (*controlStep)() = nullptr;
+
+// Store Task Handle and Lock of the shared State.
+TaskHandle_t controlHandle = nullptr;
+SemaphoreHandle_t controlMutex = nullptr;
+
+// Store Timing Statistics (Jitter and Runtime in us).
+uint32_t controlTicks = 0;
+uint32_t controlOverruns = 0;
+uint32_t controlJitter = 0;
+float controlAverage = 0;
+uint32_t controlMaximum = 0;
+uint32_t controlRuntime = 0;
+portMUX_TYPE controlMux = portMUX_INITIALIZER_UNLOCKED;
+
+
+/**
+ * @brief Starts the control task.
+ *
+ * @param step The control step, called once per period while holding the lock.
+ */
+void ControlTask::begin(void (*step)())
+{
+    controlStep = step;
+    controlMutex = xSemaphoreCreateRecursiveMutex();
+
+    xTaskCreatePinnedToCore(&run, "control", CONTROL_TASK_STACK, nullptr, CONTROL_TASK_PRIORITY, &controlHandle,
+                            CONTROL_TASK_CORE);
+
+    // Print Debug Message.
+    Guardian::println("Control Task ready");
+}
+
+/**
+ * @brief Takes the lock of the state shared between the control task and the loop.
+ *
+ * The lock is recursive, so actuators may take it again inside the control step. Before
+ * the task is started there is nothing to guard.
+ */
+void ControlTask::lock()
+{
+    if (controlMutex != nullptr)
+        xSemaphoreTakeRecursive(controlMutex, portMAX_DELAY);
+}
+
+/**
+ * @brief Releases the lock taken by lock().
+ */
+void ControlTask::unlock()
+{
+    if (controlMutex != nullptr)
+        xSemaphoreGiveRecursive(controlMutex);
+}
+
+/**
+ * @brief Retrieves the tick counters and timing values of the task.
+ *
+ * @return The summary, jitter and runtime in us.
+ */
+ControlTask::Summary ControlTask::getSummary()
+{
+    portENTER_CRITICAL(&controlMux);
+    Summary summary = {controlTicks, controlOverruns, controlJitter, static_cast<uint32_t>(controlAverage),
+                       controlMaximum, controlRuntime};
+    portEXIT_CRITICAL(&controlMux);
+
+    return summary;
+}
+
+/**
+ * @brief Runs the control step every CONTROL_TASK_PERIOD ms (task function).
+ *
+ * @param parameter Unused.
+ */
+void ControlTask::run(void* parameter)
+{
+    TickType_t wake = xTaskGetTickCount();
+    unsigned long last = micros();
+
+    while (true)
+    {
+        vTaskDelayUntil(&wake, pdMS_TO_TICKS(CONTROL_TASK_PERIOD));
+
+        unsigned long start = micros();
+
+        lock();
+        controlStep();
+        unlock();
+
+        handled(start - last, micros() - start);
+
+        last = start;
+    }
+}
+
+/**
+ * @brief Accounts a finished step.
+ *
+ * The jitter is the deviation of the time between two wake-ups from the period, it is
+ * smoothed with a gain of 1/8. The max. jitter and runtime are kept until reboot.
+ *
+ * @param elapsed The time since the previous wake-up in us.
+ * @param runtime The runtime of the step in us.
+ */
+void ControlTask::handled(unsigned long elapsed, unsigned long runtime)
+{
+    uint32_t jitter = abs(static_cast<long>(elapsed) - CONTROL_TASK_PERIOD * 1000L);
+
+    portENTER_CRITICAL(&controlMux);
+
+    controlJitter = jitter;
+    controlAverage = (controlTicks == 0 ? jitter : (7 * controlAverage + jitter) / 8);
+    controlMaximum = max(controlMaximum, jitter);
+    controlRuntime = max(controlRuntime, static_cast<uint32_t>(runtime));
+    controlTicks++;
+
+    if (runtime > CONTROL_TASK_PERIOD * 1000UL)
+        controlOverruns++;
+
+    portEXIT_CRITICAL(&controlMux);
+}
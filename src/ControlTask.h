@@ -0,0 +1,62 @@
+//
+// Created by JanHe on 16.10.2026.
+//
+
+#ifndef CONTROLTASK_H
+#define CONTROLTASK_H
+
+#include <Arduino.h>
+
+
+/**
+ * @class ControlTask
+ * @brief Runs the control step in an own FreeRTOS task with a fixed period.
+ *
+ * The task is pinned to CONTROL_TASK_CORE and wakes with vTaskDelayUntil every
+ * CONTROL_TASK_PERIOD ms, so blocking network or MQTT calls of the Arduino loop no longer
+ * stretch the control period. Every wake-up measures the deviation from the period
+ * (jitter) and the runtime of the step, a step which takes longer than the period counts
+ * as overrun. State shared with the loop is guarded by a recursive mutex (see ControlLock).
+ */
+class ControlTask
+{
+public:
+    /**
+     * @struct Summary
+     * @brief A copy of the tick counters and timing values.
+     */
+    struct Summary
+    {
+        uint32_t ticks;
+        uint32_t overruns;
+        uint32_t jitter;
+        uint32_t average;
+        uint32_t maximum;
+        uint32_t runtime;
+    };
+
+    static void begin(void (*step)());
+    static void lock();
+    static void unlock();
+    static Summary getSummary();
+
+private:
+    static void run(void* parameter);
+    static void handled(unsigned long elapsed, unsigned long runtime);
+};
+
+/**
+ * @class ControlLock
+ * @brief Holds the lock of the control task for the lifetime of the object.
+ */
+class ControlLock
+{
+public:
+    ControlLock() { ControlTask::lock(); }
+    ~ControlLock() { ControlTask::unlock(); }
+    ControlLock(const ControlLock&) = delete;
+    ControlLock& operator=(const ControlLock&) = delete;
+};
+
+
+#endif //CONTROLTASK_H
@@ -0,0 +1,76 @@
+//
+// Created by JanHe on 16.10.2026.
+//
+
+#include "ControlTrigger.h"
+
+/**
+ * @brief Constructs a control trigger.
+ *
+ * @param minInterval The shortest time between two steps in ms.
+ * @param watchdog The longest time between two steps in ms.
+ */
+ControlTrigger::ControlTrigger(unsigned long minInterval, unsigned long watchdog)
+{
+    this->minInterval = minInterval;
+    this->watchdog = watchdog;
+}
+
+/**
+ * @brief Checks whether the controller should run a step now.
+ *
+ * @param sample The latest sample of the controlled input.
+ * @param event true if a new sample should trigger a step (event mode).
+ *
+ * @return true if a step is due, the caller is expected to call handled() afterward.
+ */
+bool ControlTrigger::isDue(const MeterSample::Snapshot& sample, bool event)
+{
+    unsigned long elapsed = millis() - lastTick;
+
+    if (elapsed < minInterval)
+        return false;
+
+    // Step on fresh Sample.
+    eventTick = (event && sample.sequence != sequence);
+
+    return eventTick || elapsed >= watchdog;
+}
+
+/**
+ * @brief Accounts a finished step and measures the latency of a new sample.
+ *
+ * The latency is smoothed with a gain of 1/8, the max. value is kept until reboot.
+ *
+ * @param sample The sample the step acted on.
+ */
+void ControlTrigger::handled(const MeterSample::Snapshot& sample)
+{
+    unsigned long now = millis();
+
+    lastTick = now;
+
+    if (eventTick)
+        events++;
+    else
+        watchdogs++;
+
+    // Measure only the first Step on a Sample.
+    if (sample.sequence == 0 || sample.sequence == sequence)
+        return;
+
+    latency = now - sample.timestamp;
+    average = (sequence == 0 ? latency : (7 * average + latency) / 8);
+    maximum = max(maximum, latency);
+    sequence = sample.sequence;
+}
+
+/**
+ * @brief Retrieves the tick counters and latency values.
+ *
+ * @return The summary, latencies in ms.
+ */
+ControlTrigger::Summary ControlTrigger::getSummary() const
+{
+    return {events, watchdogs, latency, static_cast<uint32_t>(average), maximum};
+}
@@ -0,0 +1,58 @@
+//
+// Created by JanHe on 16.10.2026.
+//
+
+#ifndef CONTROLTRIGGER_H
+#define CONTROLTRIGGER_H
+
+#include <Arduino.h>
+
+#include "MeterSample.h"
+
+
+/**
+ * @class ControlTrigger
+ * @brief Decides when the controller runs its next step and measures its reaction time.
+ *
+ * In event mode a step is due as soon as a sample with a new sequence number arrives,
+ * but never faster than the min. interval. Without new samples (or without event mode)
+ * the watchdog interval keeps the controller ticking, so locks and stale checks are
+ * still handled. The latency is the time between the arrival of a sample and the first
+ * step which acted on it.
+ */
+class ControlTrigger
+{
+public:
+    /**
+     * @struct Summary
+     * @brief A copy of the tick counters and latency values.
+     */
+    struct Summary
+    {
+        uint32_t events;
+        uint32_t watchdogs;
+        uint32_t latency;
+        uint32_t average;
+        uint32_t maximum;
+    };
+
+    ControlTrigger(unsigned long minInterval, unsigned long watchdog);
+    bool isDue(const MeterSample::Snapshot& sample, bool event);
+    void handled(const MeterSample::Snapshot& sample);
+    Summary getSummary() const;
+
+private:
+    unsigned long minInterval;
+    unsigned long watchdog;
+    unsigned long lastTick = 0;
+    uint32_t sequence = 0;
+    bool eventTick = false;
+    uint32_t events = 0;
+    uint32_t watchdogs = 0;
+    uint32_t latency = 0;
+    float average = 0;
+    uint32_t maximum = 0;
+};
+
+
+#endif //CONTROLTRIGGER_H
@@ -0,0 +1,54 @@
+//
+// Created by JanHe on 16.10.2026.
+//
+
+#include "DutyDither.h"
+
+/**
+ * @brief Constructs a duty dither.
+ *
+ * @param maximum The highest duty.
+ */
+DutyDither::DutyDither(float maximum)
+{
+    this->maximum = maximum;
+}
+
+/**
+ * @brief Calculates the whole duty of the next step.
+ *
+ * At the limits of the range the residual can't be paid back, so it is bounded to one
+ * count and doesn't wind up.
+ *
+ * @param target The fractional duty.
+ *
+ * @return The duty to apply.
+ */
+uint32_t DutyDither::next(float target)
+{
+    float wanted = constrain(target, 0.0F, maximum) + residual;
+    float output = constrain(roundf(wanted), 0.0F, floorf(maximum));
+
+    residual = constrain(wanted - output, -1.0F, 1.0F);
+
+    return static_cast<uint32_t>(output);
+}
+
+/**
+ * @brief Drops the residual, e.g. after the duty was set outside the controller.
+ */
+void DutyDither::reset()
+{
+    residual = 0;
+}
+
+/**
+ * @brief Sets the highest duty (e.g. the capacity inside the phase limits).
+ *
+ * @param maximum The highest duty.
+ */
+void DutyDither::setMaximum(float maximum)
+{
+    this->maximum = maximum;
+}
+
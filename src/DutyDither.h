@@ -0,0 +1,34 @@
+//
+// Created by JanHe on 16.10.2026.
+//
+
+#ifndef DUTYDITHER_H
+#define DUTYDITHER_H
+
+#include <Arduino.h>
+
+
+/**
+ * @class DutyDither
+ * @brief A first order sigma-delta modulator of the duty.
+ *
+ * The PWM only takes whole duty counts, while the PI controller asks for a fractional
+ * duty. Every step outputs the nearest whole duty of the target plus the residual of the
+ * previous steps and keeps the new residual, so the output alternates between the two
+ * neighbouring counts and its mean over a few control ticks matches the target.
+ */
+class DutyDither
+{
+public:
+    explicit DutyDither(float maximum);
+    uint32_t next(float target);
+    void reset();
+    void setMaximum(float maximum);
+
+private:
+    float maximum;
+    float residual = 0;
+};
+
+
+#endif //DUTYDITHER_H
@@ -0,0 +1,169 @@
+//
+// Created by JanHe on 16.10.2026.
+//
+
+#include "HeaterChannel.h"
+
+#include "PinOut.h"
+
+
+/**
+ * @brief Constructs a heater channel.
+ *
+ * @param config The outputs and ratings of the channel.
+ */
+HeaterChannel::HeaterChannel(const ChannelConfig& config) : config(config),
+                                                            pattern(BURST_PACKET, static_cast<BurstPattern::Pattern>(BURST_PATTERN))
+{
+}
+
+/**
+ * @brief Configures the pins and switches the channel off.
+ */
+void HeaterChannel::begin()
+{
+    pinMode(config.enablePin, OUTPUT);
+    pinMode(config.pwmPin, OUTPUT);
+
+    // Set PWM Frequency.
+    ledcAttach(config.pwmPin, SCR_PWM_FREQUENCY, SCR_PWM_RESOLUTION);
+
+    started = true;
+
+    // Burst-Fire keeps the SCR at full Conduction, the Enable Pin fires the Cycles.
+    ledcWrite(config.pwmPin, BURST_FIRE ? SCR_PWM_RANGE : 0);
+    digitalWrite(config.enablePin, HIGH);
+}
+
+/**
+ * @brief Sets the PWM duty of the SCR.
+ *
+ * With BURST_FIRE the duty sets the share of fired mains cycles instead, which is taken
+ * over at the start of the next packet.
+ *
+ * @param duty The duty (0 to SCR_PWM_RANGE).
+ */
+void HeaterChannel::setDuty(uint32_t duty)
+{
+    duty = min(duty, static_cast<uint32_t>(SCR_PWM_RANGE));
+
+    if (duty == this->duty || !started)
+        return;
+
+    this->duty = duty;
+
+#if BURST_FIRE
+    portENTER_CRITICAL(&mux);
+    pattern.setTarget(static_cast<float>(duty) / SCR_PWM_RANGE);
+    portEXIT_CRITICAL(&mux);
+#else
+    ledcWrite(config.pwmPin, duty);
+#endif
+}
+
+/**
+ * @brief Switches the enable relay of the SCR.
+ *
+ * @param enabled true to enable the SCR.
+ */
+void HeaterChannel::setEnabled(bool enabled)
+{
+    if (enabled == this->enabled || !started)
+        return;
+
+    // Write the Pin under the Lock, so a pending tick() can not fire after switching off.
+    portENTER_CRITICAL(&mux);
+    this->enabled = enabled;
+    firing = false;
+
+    // Burst-Fire only switches off at once, the Cycles are fired by tick().
+    if (!BURST_FIRE || !enabled)
+        digitalWrite(config.enablePin, !enabled);
+
+    portEXIT_CRITICAL(&mux);
+
+    switched = millis();
+}
+
+/**
+ * @brief Fires or blocks the next mains cycle (BURST_FIRE only, timer task).
+ *
+ * Called once per BURST_CYCLE. A disabled channel restarts its pattern, so the residual
+ * of an old packet is not fired after the next enable. The pin is written under the same
+ * lock as in setEnabled(), so a switch-off is never overwritten by a late cycle.
+ */
+void HeaterChannel::tick()
+{
+    if (!started)
+        return;
+
+    portENTER_CRITICAL(&mux);
+
+    bool fire = false;
+
+    if (enabled)
+        fire = pattern.next();
+    else
+        pattern.reset();
+
+    if (fire != firing)
+        digitalWrite(config.enablePin, !fire);
+
+    firing = fire;
+
+    portEXIT_CRITICAL(&mux);
+}
+
+/**
+ * @brief Retrieves the PWM duty.
+ *
+ * @return The duty.
+ */
+uint32_t HeaterChannel::getDuty() const
+{
+    return duty;
+}
+
+/**
+ * @brief Checks if the enable relay is on.
+ *
+ * @return true if enabled.
+ */
+bool HeaterChannel::isEnabled() const
+{
+    return enabled;
+}
+
+/**
+ * @brief Estimates the power of the channel.
+ *
+ * The duty is scaled linearly to the rated power. A phase angle controlled load draws
+ * less at partial duty, so the estimate is on the safe side for the phase limits. With
+ * BURST_FIRE it is the mean power over a packet.
+ *
+ * @return The power in W.
+ */
+float HeaterChannel::getPower() const
+{
+    return (enabled ? config.power * duty / SCR_PWM_RANGE : 0.0F);
+}
+
+/**
+ * @brief Retrieves the time of the last relay switch.
+ *
+ * @return The time in ms.
+ */
+unsigned long HeaterChannel::getSwitched() const
+{
+    return switched;
+}
+
+/**
+ * @brief Retrieves the configuration of the channel.
+ *
+ * @return The configuration.
+ */
+const ChannelConfig& HeaterChannel::getConfig() const
+{
+    return config;
+}
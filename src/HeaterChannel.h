@@ -0,0 +1,61 @@
+//
+// Created by JanHe on 16.10.2026.
+//
+
+#ifndef HEATERCHANNEL_H
+#define HEATERCHANNEL_H
+
+#include <Arduino.h>
+
+#include "BurstPattern.h"
+
+
+/**
+ * @struct ChannelConfig
+ * @brief The outputs and ratings of a heater element (see HEATER_CHANNELS).
+ */
+struct ChannelConfig
+{
+    uint8_t pwmPin;
+    uint8_t enablePin;
+    float power;
+    uint8_t phase;
+    uint8_t priority;
+};
+
+
+/**
+ * @class HeaterChannel
+ * @brief A single SCR output (PWM duty and low active enable relay) of a heater element.
+ *
+ * The pins are only written on change, so the channel can be driven on every control
+ * step without extra relay or LEDC traffic. With BURST_FIRE the PWM stays at full range
+ * and the duty is turned into whole mains cycles, which tick() fires by the enable pin.
+ */
+class HeaterChannel
+{
+public:
+    explicit HeaterChannel(const ChannelConfig& config);
+    void begin();
+    void setDuty(uint32_t duty);
+    void setEnabled(bool enabled);
+    void tick();
+    uint32_t getDuty() const;
+    bool isEnabled() const;
+    float getPower() const;
+    unsigned long getSwitched() const;
+    const ChannelConfig& getConfig() const;
+
+private:
+    const ChannelConfig& config;
+    uint32_t duty = 0;
+    bool enabled = false;
+    bool started = false;
+    unsigned long switched = 0;
+    BurstPattern pattern;
+    bool firing = false;
+    portMUX_TYPE mux = portMUX_INITIALIZER_UNLOCKED;
+};
+
+
+#endif //HEATERCHANNEL_H
@@ -0,0 +1,62 @@
+//
+// Created by JanHe on 16.10.2026.
+//
+
+#ifndef HEATERCHANNELS_H
+#define HEATERCHANNELS_H
+
+#include "HeaterChannel.h"
+#include "PinOut.h"
+
+/**
+ * @brief The heater elements driven by the controller.
+ *
+ * The PowerAllocator fills the channels by ascending priority, so the first channel
+ * trims the power and further elements are staged on while the surplus grows. Every
+ * channel needs its own LEDC capable PWM pin and enable pin. A 9 kW three phase
+ * heater with one SCR per element would e.g. use
+ *
+ *     {SCR_PWM, SCR_ENABLE, 3000.0F, 1, 0},
+ *     {2, 12, 3000.0F, 2, 1},
+ *     {17, 21, 3000.0F, 3, 2},
+ *
+ * Columns: PWM Pin / Enable Pin / rated Power in W / Phase (1-3) / Priority (0 = first)
+ */
+constexpr ChannelConfig HEATER_CHANNELS[] = {
+    {SCR_PWM, SCR_ENABLE, 6000.0F, 1, 0},
+};
+
+constexpr uint8_t HEATER_CHANNEL_COUNT = sizeof(HEATER_CHANNELS) / sizeof(ChannelConfig);
+
+// Duty Range of all Channels together (the Controller Output).
+constexpr uint32_t HEATER_RANGE = HEATER_CHANNEL_COUNT * SCR_PWM_RANGE;
+
+/**
+ * @brief Sums the rated power of the heater channels.
+ *
+ * @param index The first channel to sum.
+ *
+ * @return The power in W.
+ */
+constexpr float heaterPower(uint8_t index = 0)
+{
+    return (index < HEATER_CHANNEL_COUNT ? HEATER_CHANNELS[index].power + heaterPower(index + 1) : 0.0F);
+}
+
+/**
+ * @brief Checks that the heater channels are connected to phase 1 to 3.
+ *
+ * @param index The first channel to check.
+ *
+ * @return true if every channel from index on has a valid phase.
+ */
+constexpr bool heaterPhasesValid(uint8_t index = 0)
+{
+    return (index >= HEATER_CHANNEL_COUNT || (HEATER_CHANNELS[index].phase >= 1 && HEATER_CHANNELS[index].phase <= 3 && heaterPhasesValid(index + 1)));
+}
+
+static_assert(HEATER_CHANNEL_COUNT > 0 && HEATER_CHANNEL_COUNT <= 8, "HEATER_CHANNELS must have 1 to 8 entries");
+static_assert(heaterPhasesValid(), "HEATER_CHANNELS phases must be 1 to 3");
+
+
+#endif //HEATERCHANNELS_H
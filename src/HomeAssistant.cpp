@@ -6,12 +6,16 @@
 
 #include "HomeAssistant.h"
 
+#include <climits>
+
 #include "Ethernet.h"
 #include "HADevice.h"
 #include "HAMqtt.h"
+#include "HeaterChannels.h"
 #include "Guardian.h"
 #include "LocalNetwork.h"
 #include "PinOut.h"
+#include "Recorder.h"
 #include "Watcher.h"
 #include "device-types/HABinarySensor.h"
 #include "device-types/HAButton.h"
@@ -27,8 +31,14 @@ EthernetClient client;
 // Store HADevice Instance.
 HADevice device;
 
+// Max. MQTT Subscriptions of other Modules.
+#define MQTT_SUBSCRIPTIONS 4
+
+// Max. Count of Device Types (28 Entities below, Entities beyond the Limit are silently not registered).
+#define MQTT_DEVICE_TYPES 28
+
 // Store MQTT Instance.
-HAMqtt mqtt(client, device, 18);
+HAMqtt mqtt(client, device, MQTT_DEVICE_TYPES);
 
 // Store HAVAC Instance.
 HAHVAC heating("heating", HAHVAC::TargetTemperatureFeature | HAHVAC::ModesFeature);
@@ -72,6 +82,11 @@ HANumber maxPower("heating_max_power");
 // Store Min Power.
 HANumber minPower("heating_min_power");
 
+// Store PI Controller Instances (Gains and Deadband of the DYNAMIC Mode).
+HANumber gainP("heating_gain_p", HABaseDeviceType::PrecisionP3);
+HANumber gainI("heating_gain_i", HABaseDeviceType::PrecisionP3);
+HANumber deadband("heating_deadband");
+
 // Store SCR Switch Instance.
 HASwitch scrSwitch("scr_switch");
 
@@ -84,6 +99,22 @@ HASensor error_log("heating_error");
 // Store Error Reset Instance.
 HAButton reset("heating_reset");
 
+// Store Modbus Round-Trip Time Instances (p95).
+HASensorNumber rttRTU("heating_rtt_rtu");
+HASensorNumber rttTCP("heating_rtt_tcp");
+
+// Store Modbus Timeout Counter Instance.
+HASensorNumber modbusTimeouts("heating_modbus_timeouts");
+
+// Store Meter Sample Age Instances.
+HASensorNumber agePower("heating_age_power", HABaseDeviceType::PrecisionP1);
+HASensorNumber ageHouse("heating_age_house", HABaseDeviceType::PrecisionP1);
+HASensorNumber ageConsumption("heating_age_consumption", HABaseDeviceType::PrecisionP1);
+
+// Store active House Power Source Instances.
+HASensor houseSource("heating_house_source");
+HASensorNumber houseInterval("heating_house_interval");
+
 // Store Mode Select Instance.
 // HASelect modeSelect("mode_select");
 
@@ -93,6 +124,10 @@ float lastTemp = 45;
 unsigned long lastReconnectAttempt;
 int failCounter;
 
+// Store MQTT Subscriptions of other Modules.
+HomeAssistant::Subscription subscriptions[MQTT_SUBSCRIPTIONS];
+uint8_t subscriptionCount = 0;
+
 
 /**
  * @brief Configures the pump switch instance by defining its name, icon, and behavior.
@@ -109,6 +144,8 @@ void HomeAssistant::configurePumpInstance()
 
     pumpSwitch.onCommand([](bool state, HASwitch* sender)
     {
+        Recorder::input("ha_pump", state);
+
         if (Watcher::standby)
         {
             Watcher::setPumpViaHA(state);
@@ -168,6 +205,8 @@ void HomeAssistant::configureSCRInstance()
 
     scrSwitch.onCommand([](bool state, HASwitch* sender)
     {
+        Recorder::input("ha_scr", state);
+
         if (Watcher::standby)
         {
             Watcher::setSCRViaHA(state);
@@ -218,6 +257,8 @@ void HomeAssistant::configureHeatingInstance()
     {
         Guardian::println("Temp changed");
 
+        Recorder::input("ha_target", temperature.toFloat());
+
         // Set Target Temperature.
         Watcher::setTargetTemperature(temperature.toFloat());
 
@@ -232,16 +273,22 @@ void HomeAssistant::configureHeatingInstance()
         case HAHVAC::HeatMode:
             Guardian::println("ConsumeM");
 
+            Recorder::input("ha_mode", 1);
+
             Watcher::setMode(Watcher::CONSUME);
             break;
         case HAHVAC::AutoMode:
             Guardian::println("DynamicM");
 
+            Recorder::input("ha_mode", 2);
+
             Watcher::setMode(Watcher::DYNAMIC);
             break;
         case HAHVAC::OffMode:
             Guardian::println("OffM");
 
+            Recorder::input("ha_mode", 0);
+
             Watcher::setStandby(true);
             break;
         }
@@ -295,6 +342,8 @@ void HomeAssistant::configureConsumptionInstance()
         // Check if no Reset CMD by HA.
         if (number.isSet())
         {
+            Recorder::input("ha_maxconsume", number.toFloat());
+
             Watcher::setMaxConsume(number.toFloat());
         }
 
@@ -304,6 +353,8 @@ void HomeAssistant::configureConsumptionInstance()
     consumeStart.setName("Start");
     consumeStart.onCommand([](HAButton* sender)
     {
+        Recorder::input("ha_start", 1);
+
         Watcher::startConsume();
     });
 }
@@ -343,6 +394,7 @@ void HomeAssistant::begin()
     configureConsumptionRemainInstance();
     configureMaxPowerInstance();
     configureMinPowerInstance();
+    configureControllerInstances();
     configureFaultInstances();
     configureFlowInstance();
     configureSCRInstance();
@@ -353,6 +405,9 @@ void HomeAssistant::begin()
     configureResetInstance();
     configureRestartInstance();
     configureStandbyInstance();
+    configureModbusInstances();
+    configureSampleAgeInstances();
+    configureHouseSourceInstances();
 
     // Print Debug Message.
     Guardian::println("HomeAssistant is ready");
@@ -431,11 +486,13 @@ void HomeAssistant::configureMaxPowerInstance()
     maxPower.setDeviceClass("power");
     maxPower.setUnitOfMeasurement("kW");
     maxPower.setMin(2);
-    maxPower.setMax(6);
+    maxPower.setMax(max(6.0F, heaterPower() / 1000.0F));
     maxPower.setIcon("mdi:flash");
     maxPower.setRetain(true);
     maxPower.onCommand([](HANumeric number, HANumber* sender)
     {
+        Recorder::input("ha_maxpower", number.toFloat() * 1000);
+
         Watcher::setMaxPower(number.toFloat() * 1000);
 
         sender->setState(number);
@@ -463,12 +520,76 @@ void HomeAssistant::configureMinPowerInstance()
     minPower.setIcon("mdi:flash");
     minPower.onCommand([](HANumeric number, HANumber* sender)
     {
+        Recorder::input("ha_minpower", number.toFloat());
+
         Watcher::setMinPower(number.toFloat());
 
         sender->setState(number);
     });
 }
 
+/**
+ * @brief Configures the gain and deadband instances of the PI controller.
+ *
+ * The instances start with the defaults of PinOut.h and retain their commands, so
+ * tuned values survive a reboot of the controller.
+ */
+void HomeAssistant::configureControllerInstances()
+{
+    gainP.setName("Gain P");
+    gainP.setUnitOfMeasurement("1/W");
+    gainP.setMin(0);
+    gainP.setMax(1);
+    gainP.setStep(0.001F);
+    gainP.setMode(HANumber::ModeBox);
+    gainP.setRetain(true);
+    gainP.setIcon("mdi:tune-variant");
+    gainP.setCurrentState(CONTROL_KP);
+    gainP.onCommand([](HANumeric number, HANumber* sender)
+    {
+        Recorder::input("ha_gainp", number.toFloat());
+
+        Watcher::setGainP(number.toFloat());
+
+        sender->setState(number);
+    });
+
+    gainI.setName("Gain I");
+    gainI.setUnitOfMeasurement("1/Ws");
+    gainI.setMin(0);
+    gainI.setMax(1);
+    gainI.setStep(0.001F);
+    gainI.setMode(HANumber::ModeBox);
+    gainI.setRetain(true);
+    gainI.setIcon("mdi:tune-variant");
+    gainI.setCurrentState(CONTROL_KI);
+    gainI.onCommand([](HANumeric number, HANumber* sender)
+    {
+        Recorder::input("ha_gaini", number.toFloat());
+
+        Watcher::setGainI(number.toFloat());
+
+        sender->setState(number);
+    });
+
+    deadband.setName("Deadband");
+    deadband.setDeviceClass("power");
+    deadband.setUnitOfMeasurement("W");
+    deadband.setMin(0);
+    deadband.setMax(500);
+    deadband.setRetain(true);
+    deadband.setIcon("mdi:arrow-expand-horizontal");
+    deadband.setCurrentState(CONTROL_DEADBAND);
+    deadband.onCommand([](HANumeric number, HANumber* sender)
+    {
+        Recorder::input("ha_deadband", number.toFloat());
+
+        Watcher::setDeadband(number.toFloat());
+
+        sender->setState(number);
+    });
+}
+
 /**
  * @brief Configures the PWM instance for controlling the duty cycle.
  *
@@ -481,11 +602,13 @@ void HomeAssistant::configureMinPowerInstance()
 void HomeAssistant::configurePWMInstance()
 {
     pwm.setName("Duty");
-    pwm.setMax(SCR_PWM_RANGE);
+    pwm.setMax(HEATER_RANGE);
 
     // Handle PWM Change Listener.
     pwm.onCommand([](HANumeric number, HANumber* sender)
     {
+        Recorder::input("ha_duty", number.toUInt32());
+
         if (Watcher::standby)
         {
             Watcher::setDuty(number.toUInt32());
@@ -517,12 +640,21 @@ void HomeAssistant::handleMQTT()
         Guardian::println("MQTT is disconnected");
     });
 
+    // Dispatch Messages of Subscriptions.
+    mqtt.onMessage(handleMessage);
+
     // On MQTT Connect.
     mqtt.onConnected([]
     {
         // Print Debug Message.
         Guardian::println("MQTT is connected");
 
+        // Renew Subscriptions.
+        for (uint8_t i = 0; i < subscriptionCount; i++)
+        {
+            mqtt.subscribe(subscriptions[i].topic);
+        }
+
         // Check for Errors before MQTT was initialized.
         if (Guardian::hasError())
         {
@@ -608,6 +740,111 @@ void HomeAssistant::configureConsumptionRemainInstance()
     consumeRemain.setIcon("mdi:lightbulb");
 }
 
+/**
+ * @brief Configures the Modbus diagnostic sensor instances.
+ *
+ * This method sets up the p95 round-trip time sensors of the RTU and TCP clients and
+ * the timeout counter, which allow to see whether the meter or the bus is the bottleneck.
+ */
+void HomeAssistant::configureModbusInstances()
+{
+    rttRTU.setName("RTU RTT");
+    rttRTU.setDeviceClass("duration");
+    rttRTU.setUnitOfMeasurement("ms");
+    rttRTU.setIcon("mdi:timer-outline");
+
+    rttTCP.setName("TCP RTT");
+    rttTCP.setDeviceClass("duration");
+    rttTCP.setUnitOfMeasurement("ms");
+    rttTCP.setIcon("mdi:timer-outline");
+
+    modbusTimeouts.setName("Modbus Timeouts");
+    modbusTimeouts.setStateClass("total_increasing");
+    modbusTimeouts.setIcon("mdi:timer-alert-outline");
+}
+
+/**
+ * @brief Configures the meter sample age sensor instances.
+ *
+ * This method sets up one sensor per meter input, which shows how old the value
+ * is the controller currently works with.
+ */
+void HomeAssistant::configureSampleAgeInstances()
+{
+    agePower.setName("Power Age");
+    agePower.setDeviceClass("duration");
+    agePower.setUnitOfMeasurement("s");
+    agePower.setIcon("mdi:clock-outline");
+
+    ageHouse.setName("House Power Age");
+    ageHouse.setDeviceClass("duration");
+    ageHouse.setUnitOfMeasurement("s");
+    ageHouse.setIcon("mdi:clock-outline");
+
+    ageConsumption.setName("Consumption Age");
+    ageConsumption.setDeviceClass("duration");
+    ageConsumption.setUnitOfMeasurement("s");
+    ageConsumption.setIcon("mdi:clock-outline");
+}
+
+/**
+ * @brief Configures the sensor instances of the active house power source.
+ *
+ * This method sets up the name of the source the controller currently uses and its
+ * measured update interval.
+ */
+void HomeAssistant::configureHouseSourceInstances()
+{
+    houseSource.setName("House Power Source");
+    houseSource.setIcon("mdi:transmission-tower");
+
+    houseInterval.setName("House Power Interval");
+    houseInterval.setDeviceClass("duration");
+    houseInterval.setUnitOfMeasurement("ms");
+    houseInterval.setIcon("mdi:timer-sync-outline");
+}
+
+/**
+ * @brief Subscribes a MQTT topic for another module.
+ *
+ * The topic is subscribed again after every reconnect. The callback receives the
+ * messages of all subscribed topics and has to filter them.
+ *
+ * @param topic The topic to subscribe (must stay valid).
+ * @param callback The callback which receives the messages.
+ *
+ * @return true if the subscription was stored, false if too many topics are subscribed.
+ */
+bool HomeAssistant::subscribe(const char* topic, void (*callback)(const char* topic, const uint8_t* payload,
+                                                                   uint16_t length))
+{
+    if (subscriptionCount >= MQTT_SUBSCRIPTIONS)
+        return false;
+
+    subscriptions[subscriptionCount++] = {topic, callback};
+
+    // Subscribe now if already connected.
+    if (mqtt.isConnected())
+        mqtt.subscribe(topic);
+
+    return true;
+}
+
+/**
+ * @brief Hands a received MQTT message to all subscribers.
+ *
+ * @param topic The topic of the message.
+ * @param payload The payload (not zero terminated).
+ * @param length The length of the payload.
+ */
+void HomeAssistant::handleMessage(const char* topic, const uint8_t* payload, uint16_t length)
+{
+    for (uint8_t i = 0; i < subscriptionCount; i++)
+    {
+        subscriptions[i].callback(topic, payload, length);
+    }
+}
+
 
 /**
  * @brief Continuously executes the main execution cycle of the program.
@@ -908,3 +1145,54 @@ void HomeAssistant::checkConnection()
             failCounter = 0;
     }
 }
+
+/**
+ * @brief Publishes the Modbus statistics of both clients.
+ *
+ * Only the p95 round-trip times and the sum of timeouts are published, the sensors
+ * only send a message if the value changed.
+ *
+ * @param rtu The statistics of the RTU client.
+ * @param tcp The statistics of the TCP client.
+ */
+void HomeAssistant::setModbusStats(const ModbusStats::Summary& rtu, const ModbusStats::Summary& tcp)
+{
+    rttRTU.setValue(rtu.p95);
+    rttTCP.setValue(tcp.p95);
+    modbusTimeouts.setValue(rtu.timeouts + tcp.timeouts);
+}
+
+/**
+ * @brief Publishes the age of the meter samples.
+ *
+ * Inputs which never received a value (ULONG_MAX) are skipped.
+ *
+ * @param power The age of the local power sample in ms.
+ * @param house The age of the house power sample in ms.
+ * @param consumption The age of the consumption sample in ms.
+ */
+void HomeAssistant::setSampleAges(unsigned long power, unsigned long house, unsigned long consumption)
+{
+    if (power != ULONG_MAX)
+        agePower.setValue(power / 1000.0F);
+
+    if (house != ULONG_MAX)
+        ageHouse.setValue(house / 1000.0F);
+
+    if (consumption != ULONG_MAX)
+        ageConsumption.setValue(consumption / 1000.0F);
+}
+
+/**
+ * @brief Publishes the active house power source and its update interval.
+ *
+ * @param name The name of the source.
+ * @param interval The measured interval in ms (0 if unknown).
+ */
+void HomeAssistant::setHouseSource(const char* name, unsigned long interval)
+{
+    houseSource.setValue(name);
+
+    if (interval > 0)
+        houseInterval.setValue(static_cast<uint32_t>(interval));
+}
@@ -6,6 +6,7 @@
 #define HOMEASSISTANT_H
 #include "Ethernet.h"
 #include "ModbusClientRTU.h"
+#include "ModbusStats.h"
 #include "device-types/HAHVAC.h"
 #include "device-types/HASensorNumber.h"
 #include "device-types/HASwitch.h"
@@ -41,13 +42,28 @@ private:
     static void configureErrorInstances();
     static void configureMaxPowerInstance();
     static void configureMinPowerInstance();
+    static void configureControllerInstances();
     static void configurePWMInstance();
+    static void configureModbusInstances();
+    static void configureSampleAgeInstances();
+    static void configureHouseSourceInstances();
     static void handleMQTT();
+    static void handleMessage(const char* topic, const uint8_t* payload, uint16_t length);
     static void checkConnection();
 
 
 
 public:
+    /**
+     * @struct Subscription
+     * @brief A MQTT topic subscribed by another module.
+     */
+    struct Subscription
+    {
+        const char* topic;
+        void (*callback)(const char* topic, const uint8_t* payload, uint16_t length);
+    };
+
     static void configureResetInstance();
     static void configureTemperatureInputInstance();
     static void configureStandbyInstance();
@@ -69,6 +85,11 @@ public:
     static void setStandby(bool cond);
     static void setErrorState(bool cond);
     static void setConsumptionRemain(float value);
+    static void setModbusStats(const ModbusStats::Summary& rtu, const ModbusStats::Summary& tcp);
+    static void setSampleAges(unsigned long power, unsigned long house, unsigned long consumption);
+    static void setHouseSource(const char* name, unsigned long interval);
+    static bool subscribe(const char* topic, void (*callback)(const char* topic, const uint8_t* payload,
+                                                              uint16_t length));
     static void reconnectMQTT();
 };
 
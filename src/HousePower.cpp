@@ -0,0 +1,270 @@
+//
+// Created by JanHe on 16.10.2026.
+//
+
+#include "HousePower.h"
+
+#include "Guardian.h"
+#include "HomeAssistant.h"
+#include "HttpHouseSource.h"
+#include "ModbusHouseSource.h"
+#include "MqttHouseSource.h"
+#include "PinOut.h"
+#include "Watcher.h"
+
+// Polling Policy of the Modbus TCP Meter (Min. Interval ms / Max. Interval ms / Change Threshold).
+#define POLL_HOUSE 250, 2000, 50.0F
+
+#if HOUSE_MODBUS
+// Store Modbus TCP Source.
+ModbusHouseSource modbusSource(POLL_HOUSE);
+#endif
+
+#if HOUSE_MQTT
+// Store MQTT Source.
+MqttHouseSource mqttSource(HOUSE_MQTT_TOPIC, HOUSE_MQTT_KEY);
+#endif
+
+#if HOUSE_HTTP
+// Store HTTP JSON Source.
+HttpHouseSource httpSource(HOUSE_HTTP_HOST, HOUSE_HTTP_PORT, HOUSE_HTTP_PATH, HOUSE_HTTP_KEY, HOUSE_HTTP_INTERVAL);
+#endif
+
+// Store enabled Sources in Failover Order.
+HouseSource* houseSources[] = {
+#if HOUSE_MODBUS
+    &modbusSource,
+#endif
+#if HOUSE_MQTT
+    &mqttSource,
+#endif
+#if HOUSE_HTTP
+    &httpSource,
+#endif
+};
+
+constexpr uint8_t HOUSE_SOURCE_COUNT = sizeof(houseSources) / sizeof(HouseSource*);
+
+static_assert(HOUSE_SOURCE_COUNT > 0, "At least one House Power Source must be enabled");
+
+// Store active Source (read from the Client Tasks).
+HouseSource* volatile houseActive = nullptr;
+
+
+/**
+ * @brief Starts all enabled sources, the first one is active until values arrive.
+ */
+void HousePower::begin()
+{
+    for (HouseSource* source : houseSources)
+    {
+        source->onUpdate(handleUpdate);
+        source->begin();
+    }
+
+#if HOUSE_MQTT
+    // Subscribe House Power Topic.
+    HomeAssistant::subscribe(HOUSE_MQTT_TOPIC, handleMessage);
+#endif
+
+    houseActive = houseSources[0];
+}
+
+/**
+ * @brief Polls all sources and selects the active one, should be called from the loop.
+ */
+void HousePower::poll()
+{
+    for (HouseSource* source : houseSources)
+    {
+        source->poll();
+    }
+
+    select();
+}
+
+/**
+ * @brief Receives the power register of the Modbus TCP meter (see LocalModbus bindings).
+ *
+ * @param value The house power in W.
+ */
+void HousePower::handleModbus(float value)
+{
+#if HOUSE_MODBUS
+    modbusSource.handleValue(value);
+#endif
+}
+
+/**
+ * @brief Receives the power register of phase 1 of the Modbus TCP meter.
+ *
+ * @param value The power in W.
+ */
+void HousePower::handlePhase1(float value)
+{
+#if HOUSE_MODBUS
+    modbusSource.handlePhase(0, value);
+#endif
+}
+
+/**
+ * @brief Receives the power register of phase 2 of the Modbus TCP meter.
+ *
+ * @param value The power in W.
+ */
+void HousePower::handlePhase2(float value)
+{
+#if HOUSE_MODBUS
+    modbusSource.handlePhase(1, value);
+#endif
+}
+
+/**
+ * @brief Receives the power register of phase 3 of the Modbus TCP meter.
+ *
+ * @param value The power in W.
+ */
+void HousePower::handlePhase3(float value)
+{
+#if HOUSE_MODBUS
+    modbusSource.handlePhase(2, value);
+#endif
+}
+
+/**
+ * @brief Receives the export energy register of the Modbus TCP meter.
+ *
+ * @param value The exported energy in kWh.
+ */
+void HousePower::handleExport(float value)
+{
+#if HOUSE_MODBUS
+    modbusSource.handleExport(value);
+#endif
+}
+
+/**
+ * @brief Receives a message of a subscribed MQTT topic.
+ *
+ * @param topic The topic of the message.
+ * @param payload The payload (not zero terminated).
+ * @param length The length of the payload.
+ */
+void HousePower::handleMessage(const char* topic, const uint8_t* payload, uint16_t length)
+{
+#if HOUSE_MQTT
+    mqttSource.handleMessage(topic, payload, length);
+#endif
+}
+
+/**
+ * @brief Retrieves the source whose values are used by the controller.
+ *
+ * @return The active source.
+ */
+HouseSource* HousePower::getActive()
+{
+    return houseActive;
+}
+
+/**
+ * @brief Retrieves the count of enabled sources.
+ *
+ * @return The count of sources.
+ */
+uint8_t HousePower::getCount()
+{
+    return HOUSE_SOURCE_COUNT;
+}
+
+/**
+ * @brief Retrieves an enabled source.
+ *
+ * @param index The index in configuration order.
+ *
+ * @return The source.
+ */
+HouseSource* HousePower::getSource(uint8_t index)
+{
+    return houseSources[index];
+}
+
+/**
+ * @brief Retrieves the last power of a phase of the Modbus TCP meter.
+ *
+ * @param phase The index of the phase (0-2).
+ *
+ * @return The sample, sequence 0 if never read or HOUSE_MODBUS is disabled.
+ */
+MeterSample::Snapshot HousePower::getPhase(uint8_t phase)
+{
+#if HOUSE_MODBUS
+    return modbusSource.getPhase(phase);
+#else
+    return {0.0F, 0, 0};
+#endif
+}
+
+/**
+ * @brief Retrieves the last exported energy of the Modbus TCP meter.
+ *
+ * @return The sample, sequence 0 if never read or HOUSE_MODBUS is disabled.
+ */
+MeterSample::Snapshot HousePower::getExport()
+{
+#if HOUSE_MODBUS
+    return modbusSource.getExport();
+#else
+    return {0.0F, 0, 0};
+#endif
+}
+
+/**
+ * @brief Picks the healthy source with the shortest update interval.
+ *
+ * Sources without a measured interval yet rank behind all measured ones. Only the source
+ * is switched, the Watcher receives the next fresh value of the new source by
+ * handleUpdate(). Its last value may be up to STALE_HOUSE old and would be stamped as
+ * fresh by the Watcher.
+ */
+void HousePower::select()
+{
+    HouseSource* active = houseActive;
+    HouseSource* best = nullptr;
+
+    for (HouseSource* source : houseSources)
+    {
+        if (!source->isHealthy(STALE_HOUSE))
+            continue;
+
+        unsigned long interval = source->getInterval();
+
+        if (best == nullptr || (interval > 0 && (best->getInterval() == 0 || interval < best->getInterval())))
+            best = source;
+    }
+
+    // Keep active Source if nothing is healthy.
+    if (best == nullptr || best == active)
+        return;
+
+    // Avoid flapping between Sources with similar Intervals.
+    if (active->isHealthy(STALE_HOUSE) && active->getInterval() > 0 &&
+        best->getInterval() >= active->getInterval() * HOUSE_SWITCH_RATIO)
+        return;
+
+    houseActive = best;
+
+    Guardian::println(("House " + String(best->getName())).c_str());
+}
+
+/**
+ * @brief Forwards values of the active source to the Watcher (task of the source).
+ *
+ * @param source The source which delivered the value.
+ * @param value The house power in W.
+ */
+void HousePower::handleUpdate(HouseSource* source, float value)
+{
+    if (source == houseActive)
+        Watcher::setHousePower(value);
+}
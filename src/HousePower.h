@@ -0,0 +1,48 @@
+//
+// Created by JanHe on 16.10.2026.
+//
+
+#ifndef HOUSEPOWER_H
+#define HOUSEPOWER_H
+
+#include <Arduino.h>
+
+#include "HouseSource.h"
+#include "MeterSample.h"
+
+
+/**
+ * @class HousePower
+ * @brief Picks the house power source used by the controller.
+ *
+ * All enabled sources (HOUSE_MODBUS, HOUSE_MQTT, HOUSE_HTTP) are polled in parallel.
+ * The healthy source with the shortest update interval becomes active, a faster source
+ * only takes over if its interval is below HOUSE_SWITCH_RATIO of the active one. If the
+ * active source stops delivering (older than STALE_HOUSE), the fastest of the remaining
+ * healthy sources takes over, the configuration order only decides between equal
+ * intervals. Only values of the active source reach the Watcher.
+ */
+class HousePower
+{
+public:
+    static void begin();
+    static void poll();
+    static void handleModbus(float value);
+    static void handlePhase1(float value);
+    static void handlePhase2(float value);
+    static void handlePhase3(float value);
+    static void handleExport(float value);
+    static void handleMessage(const char* topic, const uint8_t* payload, uint16_t length);
+    static HouseSource* getActive();
+    static uint8_t getCount();
+    static HouseSource* getSource(uint8_t index);
+    static MeterSample::Snapshot getPhase(uint8_t phase);
+    static MeterSample::Snapshot getExport();
+
+private:
+    static void select();
+    static void handleUpdate(HouseSource* source, float value);
+};
+
+
+#endif //HOUSEPOWER_H
@@ -0,0 +1,184 @@
+//
+// Created by JanHe on 16.10.2026.
+//
+
+#include "HouseSource.h"
+
+/**
+ * @brief Constructs a house power source.
+ *
+ * @param name The name of the source (used by the HTTP and display layers).
+ */
+HouseSource::HouseSource(const char* name)
+{
+    this->name = name;
+}
+
+/**
+ * @brief Starts the backend, called once from the setup.
+ */
+void HouseSource::begin()
+{
+}
+
+/**
+ * @brief Stores a new house power value and measures the update interval.
+ *
+ * The interval is smoothed with a gain of 1/8, so a single late value does not make
+ * the source lose its rank immediately.
+ *
+ * @param value The house power in W (negative while exporting).
+ */
+void HouseSource::update(float value)
+{
+    unsigned long now = millis();
+
+    portENTER_CRITICAL(&mux);
+
+    if (updates > 0)
+    {
+        unsigned long elapsed = now - lastUpdate;
+
+        interval = (interval == 0 ? elapsed : (7 * interval + elapsed) / 8);
+    }
+
+    lastUpdate = now;
+    updates++;
+
+    portEXIT_CRITICAL(&mux);
+
+    sample.update(value);
+
+    if (callback != nullptr)
+        callback(this, value);
+}
+
+/**
+ * @brief Sets the callback which receives every new value.
+ *
+ * @param callback The callback, invoked from the task which delivered the value.
+ */
+void HouseSource::onUpdate(void (*callback)(HouseSource* source, float value))
+{
+    this->callback = callback;
+}
+
+/**
+ * @brief Retrieves the last value of the source.
+ *
+ * @return The snapshot of the sample.
+ */
+MeterSample::Snapshot HouseSource::get()
+{
+    return sample.get();
+}
+
+/**
+ * @brief Retrieves the time since the last value.
+ *
+ * @return The age in ms, or ULONG_MAX if no value was received yet.
+ */
+unsigned long HouseSource::getAge()
+{
+    return sample.getAge();
+}
+
+/**
+ * @brief Retrieves the smoothed interval between two values.
+ *
+ * @return The interval in ms, or 0 if less than two values were received.
+ */
+unsigned long HouseSource::getInterval()
+{
+    portENTER_CRITICAL(&mux);
+    unsigned long copy = interval;
+    portEXIT_CRITICAL(&mux);
+
+    return copy;
+}
+
+/**
+ * @brief Retrieves the count of received values.
+ *
+ * @return The count of values.
+ */
+uint32_t HouseSource::getUpdates()
+{
+    portENTER_CRITICAL(&mux);
+    uint32_t copy = updates;
+    portEXIT_CRITICAL(&mux);
+
+    return copy;
+}
+
+/**
+ * @brief Checks if the source delivers values.
+ *
+ * @param maxAge The max. allowed age of the last value in ms.
+ *
+ * @return true if the last value is not older than maxAge.
+ */
+bool HouseSource::isHealthy(unsigned long maxAge)
+{
+    return !sample.isStale(maxAge);
+}
+
+/**
+ * @brief Retrieves the name of the source.
+ *
+ * @return The name.
+ */
+const char* HouseSource::getName() const
+{
+    return name;
+}
+
+/**
+ * @brief Parses a number from a plain text or a flat JSON document.
+ *
+ * Without key the whole text must be a number (e.g. the state topic of a Home Assistant
+ * sensor). With key the number following the first "key": is used, nested objects are
+ * not resolved.
+ *
+ * @param text The zero terminated text.
+ * @param key The JSON key or nullptr.
+ * @param value The parsed value.
+ *
+ * @return true if a finite number was found.
+ */
+bool HouseSource::parseValue(const char* text, const char* key, float& value)
+{
+    const char* start = text;
+
+    if (key != nullptr)
+    {
+        char pattern[48];
+        snprintf(pattern, sizeof(pattern), "\"%s\"", key);
+
+        start = strstr(text, pattern);
+
+        if (start == nullptr)
+            return false;
+
+        start = strchr(start + strlen(pattern), ':');
+
+        if (start == nullptr)
+            return false;
+
+        start++;
+    }
+
+    // Skip Whitespace and Quotes of String Values.
+    while (*start == ' ' || *start == '"')
+        start++;
+
+    char* end;
+    float parsed = strtof(start, &end);
+
+    if (end == start || !std::isfinite(parsed))
+        return false;
+
+    value = parsed;
+
+    return true;
+}
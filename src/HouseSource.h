@@ -0,0 +1,52 @@
+//
+// Created by JanHe on 16.10.2026.
+//
+
+#ifndef HOUSESOURCE_H
+#define HOUSESOURCE_H
+
+#include <Arduino.h>
+
+#include "MeterSample.h"
+
+
+/**
+ * @class HouseSource
+ * @brief A backend which delivers the power of the house meter.
+ *
+ * Every backend stamps its values in a MeterSample and measures the interval between
+ * two values (smoothed like the SRTT of the RttEstimator), which is used by HousePower
+ * to pick the fastest healthy source. Values may arrive from other tasks (Modbus or TCP
+ * client), so the interval is guarded by a critical section.
+ */
+class HouseSource
+{
+public:
+    explicit HouseSource(const char* name);
+    virtual ~HouseSource() = default;
+    virtual void begin();
+    virtual void poll() = 0;
+    void update(float value);
+    void onUpdate(void (*callback)(HouseSource* source, float value));
+    MeterSample::Snapshot get();
+    unsigned long getAge();
+    unsigned long getInterval();
+    uint32_t getUpdates();
+    bool isHealthy(unsigned long maxAge);
+    const char* getName() const;
+
+protected:
+    static bool parseValue(const char* text, const char* key, float& value);
+
+private:
+    const char* name;
+    MeterSample sample;
+    void (*callback)(HouseSource* source, float value) = nullptr;
+    unsigned long interval = 0;
+    unsigned long lastUpdate = 0;
+    uint32_t updates = 0;
+    portMUX_TYPE mux = portMUX_INITIALIZER_UNLOCKED;
+};
+
+
+#endif //HOUSESOURCE_H
@@ -0,0 +1,127 @@
+//
+// Created by JanHe on 16.10.2026.
+//
+
+#include "HttpHouseSource.h"
+
+/**
+ * @brief Constructs the HTTP JSON source.
+ *
+ * @param host The IP address of the energy meter.
+ * @param port The HTTP port of the energy meter.
+ * @param path The path of the JSON API.
+ * @param key The JSON key of the house power in W.
+ * @param interval The polling interval in ms.
+ */
+HttpHouseSource::HttpHouseSource(const char* host, uint16_t port, const char* path, const char* key,
+                                 unsigned long interval) : HouseSource("http")
+{
+    this->host = host;
+    this->port = port;
+    this->path = path;
+    this->key = key;
+    this->interval = interval;
+}
+
+/**
+ * @brief Registers the handlers of the TCP client.
+ */
+void HttpHouseSource::begin()
+{
+    client.onConnect([](void* arg, AsyncClient* client)
+    {
+        static_cast<HttpHouseSource*>(arg)->handleConnect();
+    }, this);
+
+    client.onData([](void* arg, AsyncClient* client, void* data, size_t length)
+    {
+        static_cast<HttpHouseSource*>(arg)->handleData(static_cast<uint8_t*>(data), length);
+    }, this);
+
+    client.onDisconnect([](void* arg, AsyncClient* client)
+    {
+        static_cast<HttpHouseSource*>(arg)->handleDisconnect();
+    }, this);
+
+    client.onError([](void* arg, AsyncClient* client, int8_t error)
+    {
+        static_cast<HttpHouseSource*>(arg)->busy = false;
+    }, this);
+}
+
+/**
+ * @brief Sends the next request if the interval elapsed.
+ *
+ * A request which is not answered within two intervals is aborted.
+ */
+void HttpHouseSource::poll()
+{
+    unsigned long now = millis();
+
+    if (busy)
+    {
+        // Abort hanging Request.
+        if (now - lastPoll > 2 * interval)
+            client.close(true);
+
+        return;
+    }
+
+    if (now - lastPoll < interval)
+        return;
+
+    lastPoll = now;
+    length = 0;
+    busy = client.connect(host, port);
+}
+
+/**
+ * @brief Sends the GET request after the connection is established (TCP task).
+ */
+void HttpHouseSource::handleConnect()
+{
+    char request[192];
+
+    snprintf(request, sizeof(request), "GET %s HTTP/1.0\r\nHost: %s\r\nAccept: application/json\r\n\r\n", path,
+             host);
+
+    client.write(request);
+}
+
+/**
+ * @brief Collects the response (TCP task).
+ *
+ * @param data The received bytes.
+ * @param length The count of received bytes.
+ */
+void HttpHouseSource::handleData(const uint8_t* data, size_t length)
+{
+    // Drop Bytes of oversized Responses.
+    size_t size = min(length, sizeof(buffer) - 1 - this->length);
+
+    memcpy(buffer + this->length, data, size);
+    this->length += size;
+}
+
+/**
+ * @brief Parses the response after the meter closed the connection (TCP task).
+ *
+ * The source stays busy until the buffer is parsed, so poll() can not start the next
+ * request into the buffer meanwhile.
+ */
+void HttpHouseSource::handleDisconnect()
+{
+    buffer[length] = '\0';
+
+    // Only accept successful Responses.
+    bool ok = (strncmp(buffer, "HTTP/1.", 7) == 0 && strncmp(buffer + 8, " 200", 4) == 0);
+
+    const char* body = ok ? strstr(buffer, "\r\n\r\n") : nullptr;
+    float value;
+
+    if (body != nullptr && parseValue(body + 4, key, value))
+        update(value);
+
+    // Release the Buffer for the next Request only after parsing.
+    busy = false;
+}
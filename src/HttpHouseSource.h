@@ -0,0 +1,48 @@
+//
+// Created by JanHe on 16.10.2026.
+//
+
+#ifndef HTTPHOUSESOURCE_H
+#define HTTPHOUSESOURCE_H
+
+#include <AsyncTCP.h>
+
+#include "HouseSource.h"
+
+// Max. Size of a HTTP Response (Header and Body).
+#define HOUSE_HTTP_BUFFER 1536
+
+
+/**
+ * @class HttpHouseSource
+ * @brief Polls the house power from the JSON API of a local energy meter.
+ *
+ * A plain HTTP/1.0 GET is sent with an AsyncClient (like the Modbus TCP client), so the
+ * loop never blocks on the network. The response is parsed once the meter closes the
+ * connection.
+ */
+class HttpHouseSource : public HouseSource
+{
+public:
+    HttpHouseSource(const char* host, uint16_t port, const char* path, const char* key, unsigned long interval);
+    void begin() override;
+    void poll() override;
+
+private:
+    void handleConnect();
+    void handleData(const uint8_t* data, size_t length);
+    void handleDisconnect();
+    AsyncClient client;
+    const char* host;
+    uint16_t port;
+    const char* path;
+    const char* key;
+    unsigned long interval;
+    unsigned long lastPoll = 0;
+    volatile bool busy = false;
+    char buffer[HOUSE_HTTP_BUFFER];
+    size_t length = 0;
+};
+
+
+#endif //HTTPHOUSESOURCE_H
@@ -4,11 +4,22 @@
 #include "LocalModbus.h"
 #include <HardwareSerial.h>
 #include <WebServer.h>
+#include "BaudNegotiator.h"
+#include "ControlTask.h"
 #include "Guardian.h"
+#include "HousePower.h"
 #include "PinOut.h"
+#include "MeterMirror.h"
 #include "MeterRegisters.h"
 #include "ModbusClientRTU.h"
 #include "ModbusClientTCPasync.h"
+#include "ModbusScheduler.h"
+#include "ModbusStats.h"
+#include "PollPolicy.h"
+#include "ReadPlanner.h"
+#include "RegisterCodec.h"
+#include "RttEstimator.h"
+#include "TcpSupervisor.h"
 #include "Watcher.h"
 #ifdef DEBUG
 #include "WebSerial.h"
@@ -23,12 +34,61 @@ ModbusClientTCPasync* modbusTCP;
 // Store Modbus Instance.
 ModbusClientRTU* modbusRTU;
 
+// Store Scheduler of local (RTU) Requests.
+ModbusScheduler localScheduler(MODBUS_INFLIGHT_LIMIT);
 
-// Store local Queue.
-int localQueue = 0;
+// Store Scheduler of remote (TCP) Requests.
+ModbusScheduler remoteScheduler(MODBUS_TCP_INFLIGHT);
 
-// Store remote Queue.
-int remoteQueue = 0;
+// Store Statistics of local (RTU) Requests.
+ModbusStats localStats;
+
+// Store Statistics of remote (TCP) Requests.
+ModbusStats remoteStats;
+
+// Store Statistics of local (RTU) Requests by Device (see METER_DEVICES).
+ModbusStats deviceStats[METER_DEVICE_COUNT];
+
+// Store Token and Start in µs of the RTU Request timed on the Wire (sent to an idle Client).
+uint32_t wireToken = 0;
+uint32_t wireStart = 0;
+bool wirePending = false;
+portMUX_TYPE wireMux = portMUX_INITIALIZER_UNLOCKED;
+
+// Store Poll Policies of the Register Maps by Device (see METER_DEVICES).
+PollPolicy* devicePolicies[METER_DEVICE_COUNT];
+
+// Store RTT Estimation and adaptive Timeout of local (RTU) Requests.
+RttEstimator localRtt(MODBUS_TIMEOUT_INITIAL, MODBUS_TIMEOUT_MIN, MODBUS_TIMEOUT_MAX);
+
+// Store RTT Estimation and adaptive Timeout of remote (TCP) Requests.
+RttEstimator remoteRtt(MODBUS_TIMEOUT_INITIAL, MODBUS_TIMEOUT_MIN, MODBUS_TIMEOUT_MAX);
+
+// Store Bindings of the local Meter Registers (see METER_REGISTERS).
+constexpr LocalModbus::RegisterBinding localBindings[] = {
+    {POWER_USAGE, Watcher::setPower},
+    {POWER_IMPORT, Watcher::setConsumption},
+};
+
+// Store Bindings of the remote House Meter Registers (see METER_REGISTERS).
+constexpr LocalModbus::RegisterBinding remoteBindings[] = {
+    {POWER_USAGE, HousePower::handleModbus},
+    {PHASE_1_POWER, HousePower::handlePhase1},
+    {PHASE_2_POWER, HousePower::handlePhase2},
+    {PHASE_3_POWER, HousePower::handlePhase3},
+    {POWER_EXPORT, HousePower::handleExport},
+};
+
+// Store Buffer of the last sniffed Frame (max. RTU Frame Size).
+uint8_t sniffBuffer[256];
+
+// Store last sniffed Request of another Master.
+ReadPlanner::Block sniffRequest = {0, 0, 0};
+unsigned long sniffSentAt = 0;
+bool sniffPending = false;
+
+constexpr uint8_t LOCAL_BINDING_COUNT = sizeof(localBindings) / sizeof(LocalModbus::RegisterBinding);
+constexpr uint8_t REMOTE_BINDING_COUNT = sizeof(remoteBindings) / sizeof(LocalModbus::RegisterBinding);
 
 
 /**
@@ -48,130 +108,372 @@ void LocalModbus::begin()
     // Print Debug Message.
     Guardian::boot(50, "Modbus");
 
+    // Create Poll Policies of all Devices.
+    for (uint8_t i = 0; i < METER_DEVICE_COUNT; i++)
+    {
+        const MeterDevice& device = METER_DEVICES[i];
+
+        devicePolicies[i] = new PollPolicy(device.minInterval, device.maxInterval, device.threshold);
+    }
+
+#if MODBUS_SNIFFER
+    // Listen to another Master.
+    beginSniffer();
+#else
     // Begin Modbus RTU Client.
     beginRTU();
+#endif
 
     // Begin Modbus TCP Client.
     beginTCP();
 
+    // Begin Modbus TCP Server (Mirror of the local Meter).
+    MeterMirror::begin();
+
     // Print Debug Message.
     Guardian::println("Modbus ready");
 }
 
-void LocalModbus::loop()
+/**
+ * @brief Sends the collected register reads as coalesced block requests.
+ *
+ * All registers wanted via readLocal() and readRemote() are merged into block requests
+ * by the schedulers of both clients. Registers which are already in flight are not
+ * requested again, and only as many blocks as free in-flight slots are enqueued.
+ * The register maps of all devices on the RTU bus are wanted by their poll policies.
+ * Runs with the control step (see Watcher::control()), so the polling, the baud rate
+ * negotiation and the TCP supervision do not wait for a blocking MQTT loop.
+ */
+void LocalModbus::flush()
 {
+    ReadPlanner::Block blocks[MODBUS_INFLIGHT_LIMIT];
+    uint8_t count;
+
+#if !MODBUS_SNIFFER
+    // Want Register Maps of all Devices.
+    handlePolling();
+
+    // Negotiate Baud Rate of the local Meter.
+    BaudNegotiator::loop(localScheduler.getInFlight() == 0);
+
+    // Flush local Requests (held back while the Baud Rate is negotiated).
+    if (!BaudNegotiator::isBusy())
+    {
+        bool idle = (localScheduler.getInFlight() == 0);
+
+        count = localScheduler.next(blocks, MODBUS_INFLIGHT_LIMIT);
+
+        for (uint8_t i = 0; i < count; i++)
+        {
+            uint8_t device = blocks[i].device;
+
+            // Time the first Block on the Wire if it does not queue behind others.
+            if (i == 0 && idle)
+                startWire(ReadPlanner::toToken(blocks[i]));
+
+            if (requestBlock(modbusRTU, localScheduler, localStats, blocks[i], METER_DEVICES[device].serverID))
+                deviceStats[device].request();
+            else if (i == 0 && idle)
+                stopWire(ReadPlanner::toToken(blocks[i]));
+        }
+    }
+#endif
+
+    // Supervise Connection of the House Meter.
+    TcpSupervisor::loop();
+
+    // Flush remote Requests (held back while reconnecting).
+    if (TcpSupervisor::isReady())
+    {
+        count = remoteScheduler.next(blocks, MODBUS_INFLIGHT_LIMIT);
+
+        for (uint8_t i = 0; i < count; i++)
+        {
+            requestBlock(modbusTCP, remoteScheduler, remoteStats, blocks[i], MODBUS_TCP_SERVER_ID);
+        }
+    }
+
+    // Update Request Rates and RTT Percentiles.
+    localStats.update();
+    remoteStats.update();
+
+    for (uint8_t i = 0; i < METER_DEVICE_COUNT; i++)
+    {
+        deviceStats[i].update();
+    }
 }
 
 /**
- * @brief Reads a 32-bit float value from a remote Modbus input register.
+ * @brief Wants the register map of every device whose poll policy is due.
  *
- * This method interacts with the Modbus TCP client to read data from a specified
- * remote input register address. The data is read as two 16-bit Modbus registers
- * and converted to a 32-bit float value using a Big-Endian format. If the read
- * operation is unsuccessful, the method will return a default error value.
+ * The registers of the heater meter (first device) which are bound to the Watcher are
+ * skipped, they are wanted by the poll policies of the Watcher only (see readLocal()),
+ * so e.g. the consumption keeps its slower POLL_CONSUMPTION interval.
+ */
+void LocalModbus::handlePolling()
+{
+    for (uint8_t i = 0; i < METER_DEVICE_COUNT; i++)
+    {
+        if (!devicePolicies[i]->isDue())
+            continue;
+
+        const RegisterMap& map = METER_DEVICES[i].map;
+
+        for (uint8_t j = 0; j < map.count; j++)
+        {
+            if (i == 0 && isBound(map.registers[j].address, localBindings, LOCAL_BINDING_COUNT))
+                continue;
+
+            localScheduler.want(i, map.registers[j].address);
+        }
+    }
+}
+
+/**
+ * @brief Checks if a register is bound to a setter.
  *
- * @param address The address of the remote input register to be read.
+ * @param address The start address of the register.
+ * @param bindings The bindings to search.
+ * @param count The count of bindings.
  *
- * @return The 32-bit float value retrieved from the specified address on success,
- * or -1 if the read operation fails.
+ * @return true if the register is bound.
  */
-float LocalModbus::readRemote(int address)
+bool LocalModbus::isBound(uint16_t address, const RegisterBinding* bindings, uint8_t count)
 {
-    handleReadMessage("Remote", address);
-
-    // Clear Queue if to full.
-    if (remoteQueue > 50)
+    for (uint8_t i = 0; i < count; i++)
     {
-        modbusTCP->clearQueue();
-        modbusTCP->resetCounts();
-        remoteQueue = 0;
+        if (bindings[i].address == address)
+            return true;
     }
 
-    // Increment Queue.
-    remoteQueue++;
-
-    // https://github.com/eModbus/eModbus/blob/648a14b2f49de0c3ffcd9821e6b7a1180fd3f3f4/examples/RTU16example/main.cpp#L64
-    // uint32_t token, uint8_t serverID, uint8_t functionCode, uint16_t p1, uint16_t p2
-    Error error = modbusTCP->addRequest(address, MODBUS_CORE, READ_INPUT_REGISTER, address, REGISTER_LENGTH);
+    return false;
+}
 
-    handleRequestError(error);
+/**
+ * @brief Marks a remote input register to be read using Modbus TCP.
+ *
+ * The register is requested with the next loop(), unless it is already in flight.
+ *
+ * @param address The address of the remote input register to be read.
+ *
+ * @return true if the register was marked, false if too many registers are wanted already.
+ */
+bool LocalModbus::readRemote(int address)
+{
+    handleReadMessage("Remote", address);
 
-    return (error == SUCCESS);
+    return remoteScheduler.want(0, address);
 }
 
 /**
- * @brief Reads local input registers using Modbus RTU.
+ * @brief Marks a local input register of the heater meter to be read using Modbus RTU.
  *
- * This function attempts to read input registers from a specified address using the Modbus RTU protocol.
- * If the Modbus RTU server is inactive, a read request is initiated for the given address and callback.
- * The function then processes the Modbus task queue to execute the request.
+ * The register is not requested immediately. All registers marked within one loop are
+ * merged into block requests by loop(), so registers close to each other share one
+ * RTU round trip. Registers which are already in flight are not requested twice.
  *
- * @param address The starting address of the input registers to read.
- * @param callback A callback of type cbTransaction to handle the result or errors from the read operation.
+ * @param address The starting address of the input register to read.
  *
- * @note Uses a fixed register length defined as REGISTER_LENGTH. Ensure this value matches
- *       the expected number of registers for the given address.
+ * @return true if the register was marked, false if too many registers are wanted already.
  *
- * @attention If the Modbus RTU server is not active, a warning message is logged via the Guardian system.
- *            Ensure that Modbus communication is properly initialized and active before calling this function.
- *
- * @see ModbusRTU::readIreg
- * @see ModbusRTU::task
+ * @see LocalModbus::loop
+ * @see ModbusScheduler::next
  */
 bool LocalModbus::readLocal(int address)
 {
     handleReadMessage("Local", address);
 
-    // Clear Queue if to full.
-    if (localQueue > 50)
-    {
-        modbusRTU->clearQueue();
-        modbusRTU->resetCounts();
-        localQueue = 0;
-    }
+    return localScheduler.want(0, address);
+}
+
+/**
+ * @brief Enqueues a single block request on a Modbus client.
+ *
+ * The block is encoded into the request token, which is used by the data handlers
+ * to split the response back into single register values. The request is marked as
+ * in flight before it is enqueued and released again if the client rejects it.
+ *
+ * @param client The Modbus client to enqueue the request on.
+ * @param scheduler The scheduler of the client.
+ * @param stats The statistics of the client.
+ * @param block The block of registers to read.
+ * @param serverID The Server ID of the device.
+ *
+ * @return true if the request was created successfully, false otherwise.
+ */
+bool LocalModbus::requestBlock(ModbusClient* client, ModbusScheduler& scheduler, ModbusStats& stats,
+                               const ReadPlanner::Block& block, uint8_t serverID)
+{
+    uint32_t token = ReadPlanner::toToken(block);
 
-    // Increment Queue.
-    localQueue++;
+    // Reserve in-flight Slot.
+    if (!scheduler.sent(token))
+        return false;
 
     // https://github.com/eModbus/eModbus/blob/648a14b2f49de0c3ffcd9821e6b7a1180fd3f3f4/examples/RTU16example/main.cpp#L64
     // uint32_t token, uint8_t serverID, uint8_t functionCode, uint16_t p1, uint16_t p2
-    Error error = modbusRTU->addRequest(address, MODBUS_CORE, READ_INPUT_REGISTER, address, REGISTER_LENGTH);
+    Error error = client->addRequest(scheduler.tag(token), serverID, READ_INPUT_REGISTER, block.address,
+                                     block.length);
 
     handleRequestError(error);
 
+    // Release Slot if Request was rejected.
+    if (error != SUCCESS)
+        scheduler.complete(token);
+    else
+        stats.request();
+
     return (error == SUCCESS);
 }
 
 /**
- * @brief Retrieves the count of pending TCP Modbus messages in the queue.
+ * @brief Starts timing an RTU request on the wire.
+ *
+ * @param token The token of the request.
+ */
+void LocalModbus::startWire(uint32_t token)
+{
+    portENTER_CRITICAL(&wireMux);
+    wireToken = token;
+    wireStart = micros();
+    wirePending = true;
+    portEXIT_CRITICAL(&wireMux);
+}
+
+/**
+ * @brief Stops timing an RTU request on the wire.
  *
- * This method accesses the ModbusClientTCPasync instance to fetch the
- * number of Modbus TCP messages currently queued for processing.
+ * @param token The token of the answered or failed request.
  *
- * @return The count of messages in the Modbus TCP queue as a long integer.
- **/
-long LocalModbus::getQueueTCP()
+ * @return The duration in µs, or -1 if the request was not timed.
+ */
+long LocalModbus::stopWire(uint32_t token)
 {
-    return modbusTCP->getMessageCount();
+    long duration = -1;
+
+    portENTER_CRITICAL(&wireMux);
+
+    if (wirePending && wireToken == token)
+    {
+        duration = static_cast<long>(micros() - wireStart);
+        wirePending = false;
+    }
+
+    portEXIT_CRITICAL(&wireMux);
+
+    return duration;
 }
 
 /**
- * @brief Retrieves the current count of pending Modbus RTU messages.
+ * @brief Retrieves the count of TCP Modbus requests currently in flight.
  *
- * This method queries the associated Modbus RTU client instance to determine
- * the number of messages currently waiting in the message queue.
+ * This method accesses the remote scheduler to fetch the number of Modbus TCP
+ * requests which are enqueued and not yet answered or timed out.
  *
- * @return The number of pending Modbus RTU messages in the queue.
+ * @return The real depth of the Modbus TCP queue as a long integer.
+ **/
+long LocalModbus::getQueueTCP()
+{
+    return remoteScheduler.getInFlight();
+}
+
+/**
+ * @brief Retrieves the current count of Modbus RTU requests in flight.
  *
- * @note This function relies on the Modbus RTU client being properly initialized
- * and configured before invocation.
+ * This method queries the local scheduler to determine the number of requests
+ * which are enqueued on the RTU client and not yet answered or timed out.
  *
- * @attention Ensure that the Modbus RTU client (`modbusRTU`) is accessible and valid,
- * as the function interacts directly with its message count retrieval mechanism.
+ * @return The real depth of the Modbus RTU queue.
  **/
 long LocalModbus::getQueueRTU()
 {
-    return modbusRTU->getMessageCount();
+    return localScheduler.getInFlight();
+}
+
+/**
+ * @brief Retrieves how the DE/RE pin of the RS485 transceiver is driven.
+ *
+ * Used to label the RTU statistics when comparing both modes.
+ *
+ * @return "uart" if the UART drives the pin, "gpio" if the RTU client toggles it.
+ */
+const char* LocalModbus::getRS485Mode()
+{
+#if MODBUS_RS485_HARDWARE
+    return "uart";
+#else
+    return "gpio";
+#endif
+}
+
+/**
+ * @brief Retrieves the baud rate of the RTU link.
+ *
+ * @return The baud rate negotiated with the local meter (MODBUS_BAUD while sniffing).
+ */
+uint32_t LocalModbus::getBaudRate()
+{
+#if MODBUS_SNIFFER
+    return MODBUS_BAUD;
+#else
+    return BaudNegotiator::getBaudRate();
+#endif
+}
+
+/**
+ * @brief Retrieves the statistics of the Modbus RTU client.
+ *
+ * @return A snapshot of request rate, RTT percentiles and error counters.
+ */
+ModbusStats::Summary LocalModbus::getStatsRTU()
+{
+    return localStats.getSummary();
+}
+
+/**
+ * @brief Retrieves the statistics of the Modbus TCP client.
+ *
+ * @return A snapshot of request rate, RTT percentiles and error counters.
+ */
+ModbusStats::Summary LocalModbus::getStatsTCP()
+{
+    return remoteStats.getSummary();
+}
+
+/**
+ * @brief Retrieves the connection counters of the Modbus TCP client.
+ *
+ * @return A snapshot of state, reconnects, probes and in-flight depth.
+ */
+TcpSupervisor::Summary LocalModbus::getLinkTCP()
+{
+    // Serialize with the Control Task.
+    ControlLock lock;
+
+    return TcpSupervisor::getSummary();
+}
+
+/**
+ * @brief Reconnects the Modbus TCP client, e.g. after the network was restarted.
+ */
+void LocalModbus::reconnectTCP()
+{
+    // Serialize with the Control Task.
+    ControlLock lock;
+
+    TcpSupervisor::reconnect();
+}
+
+/**
+ * @brief Retrieves the statistics of a single device on the RTU bus.
+ *
+ * @param device The index of the device (see METER_DEVICES).
+ *
+ * @return A snapshot of request rate, RTT percentiles and error counters.
+ */
+ModbusStats::Summary LocalModbus::getStatsDevice(uint8_t device)
+{
+    return deviceStats[device].getSummary();
 }
 
 /**
@@ -240,6 +542,121 @@ void LocalModbus::handleResponseError(Error error, uint32_t token)
     }
 }
 
+/**
+ * @brief Handles response errors of the Modbus RTU client.
+ *
+ * Releases the in-flight slot of the failed request, so the register can be requested
+ * again with the next loop, accounts the error and logs it. A timeout backs off the
+ * adaptive timeout of the client and retries the block.
+ *
+ * @param error The error code associated with the Modbus response.
+ * @param token The token of the failed block request.
+ */
+void LocalModbus::handleLocalError(Error error, uint32_t token)
+{
+    // Response of the Baud Rate Negotiation.
+    if (BaudNegotiator::isToken(token))
+    {
+        BaudNegotiator::handleError(error);
+
+        return;
+    }
+
+    if (error == CRC_ERROR)
+        BaudNegotiator::crcError();
+
+    localScheduler.complete(token);
+    localStats.error(token, error);
+    deviceStatsOf(token).error(token, error);
+    stopWire(token);
+
+    if (error == TIMEOUT)
+    {
+        // Back off Timeout.
+        modbusRTU->setTimeout(estimateTimeout(localRtt, localStats, -1));
+
+        if (localScheduler.retry(token))
+            localStats.retry();
+    }
+
+    handleResponseError(error, token);
+}
+
+/**
+ * @brief Handles response errors of the Modbus TCP client.
+ *
+ * Releases the in-flight slot of the failed request, so the register can be requested
+ * again with the next loop, accounts the error and logs it. A timeout backs off the
+ * adaptive timeout of the client and retries the block. Errors of requests sent before
+ * the last reconnect are dropped.
+ *
+ * @param error The error code associated with the Modbus response.
+ * @param token The tagged token of the failed block request (see ModbusScheduler::tag).
+ */
+void LocalModbus::handleRemoteError(Error error, uint32_t token)
+{
+    // Drop Errors of Requests sent before the last Reconnect.
+    if (!remoteScheduler.isCurrent(token))
+        return;
+
+    token = ModbusScheduler::untag(token);
+
+    TcpSupervisor::handleError(error);
+
+    remoteScheduler.complete(token);
+    remoteStats.error(token, error);
+
+    if (error == TIMEOUT)
+    {
+        // Back off Timeout.
+        modbusTCP->setTimeout(estimateTimeout(remoteRtt, remoteStats, -1));
+
+        if (remoteScheduler.retry(token))
+            remoteStats.retry();
+    }
+
+    handleResponseError(error, token);
+}
+
+/**
+ * @brief Retrieves the statistics of the device of a local block request.
+ *
+ * @param token The token of the block request (see ReadPlanner::toToken).
+ *
+ * @return The statistics of the device, or of the first device if the token is unknown.
+ */
+ModbusStats& LocalModbus::deviceStatsOf(uint32_t token)
+{
+    uint8_t device = ReadPlanner::fromToken(token).device;
+
+    return deviceStats[device < METER_DEVICE_COUNT ? device : 0];
+}
+
+/**
+ * @brief Feeds the RTT estimator of a client and derives its new request timeout.
+ *
+ * A measured round-trip time updates SRTT and RTTVAR, a timeout (negative RTT) doubles
+ * the current timeout. The result is always kept between MODBUS_TIMEOUT_MIN and
+ * MODBUS_TIMEOUT_MAX. Must be called from the client task which owns the estimator.
+ *
+ * @param estimator The RTT estimator of the client.
+ * @param stats The statistics of the client.
+ * @param rtt The round-trip time in ms, or -1 if the request timed out.
+ *
+ * @return The timeout in ms for the next requests.
+ */
+uint32_t LocalModbus::estimateTimeout(RttEstimator& estimator, ModbusStats& stats, long rtt)
+{
+    if (rtt >= 0)
+        estimator.sample(rtt);
+    else
+        estimator.timeout();
+
+    stats.timing(estimator.getSmoothed(), estimator.getTimeout());
+
+    return estimator.getTimeout();
+}
+
 /**
  * @brief Initializes the Modbus RTU communication system.
  *
@@ -250,9 +667,15 @@ void LocalModbus::handleResponseError(Error error, uint32_t token)
  * on the specified serial interface.
  *
  * @note This function assumes that the RX (MODBUS_RX), TX (MODBUS_TX), and RE (MODBUS_RE) pins,
- * as well as other communication parameters like the baud rate (MODBUS_BAUD) and timeout (MODBUS_TIMEOUT),
+ * as well as other communication parameters like the baud rate (MODBUS_BAUD) and timeout (MODBUS_TIMEOUT_INITIAL),
  * are predefined.
  *
+ * With MODBUS_RS485_HARDWARE the DE/RE pin is driven by the UART itself (RS485 half duplex
+ * mode) instead of being toggled by the RTU client task, which shortens the turnaround
+ * between the last transmitted byte and receiving.
+ *
+ * The serial is started at the last baud rate negotiated by the BaudNegotiator.
+ *
  * @attention Ensure the hardware is properly configured, and the RS485 driver is correctly
  * connected to the respective pins before invoking this function.
  */
@@ -261,20 +684,36 @@ void LocalModbus::beginRTU()
     // Prepare Hardware Serial.
     RTUutils::prepareHardwareSerial(serial);
 
-    // Begin Second Serial Channel.
-    serial.begin(MODBUS_BAUD, SERIAL_8N1, MODBUS_RX, MODBUS_TX);
-
+#if MODBUS_RS485_HARDWARE
+    // Initialize RTU Instance (no DE/RE Pin, done by the UART).
+    modbusRTU = new ModbusClientRTU();
+#else
     // Initialize RTU Instance.
     modbusRTU = new ModbusClientRTU(MODBUS_RE);
+#endif
+
+    // Load last negotiated Baud Rate.
+    BaudNegotiator::begin(modbusRTU, &serial);
+
+    // Begin Second Serial Channel.
+    serial.begin(BaudNegotiator::getBaudRate(), SERIAL_8N1, MODBUS_RX, MODBUS_TX);
+
+#if MODBUS_RS485_HARDWARE
+    // Let the UART drive DE/RE via RTS.
+    serial.setPins(MODBUS_RX, MODBUS_TX, -1, MODBUS_RE);
+
+    if (!serial.setMode(UART_MODE_RS485_HALF_DUPLEX))
+        Guardian::println("RS485 Mode failed");
+#endif
 
     // Add Error Handler.
-    modbusRTU->onErrorHandler(handleResponseError);
+    modbusRTU->onErrorHandler(handleLocalError);
 
-    // Add Message Handler.
+    // Add Message Handler (eModbus passes a Copy of the Response, the Handlers only read it from there on).
     modbusRTU->onDataHandler(handleLocalData);
 
-    // Set Timeout.
-    modbusRTU->setTimeout(MODBUS_TIMEOUT);
+    // Set initial Timeout (adapted to the measured RTT afterward).
+    modbusRTU->setTimeout(localRtt.getTimeout());
 
     // Begin Modbus RTU Client.
     modbusRTU->begin(serial, MODBUS_CORE);
@@ -284,88 +723,266 @@ void LocalModbus::beginRTU()
 }
 
 /**
- * @brief Handles the response for a Modbus query and extracts float values from it.
+ * @brief Starts listening to the RTU bus without sending anything.
  *
- * This function processes the incoming Modbus message, extracting data in the form of IEEE754
- * float32 values from the message payload. It logs the server ID, function code, token,
- * message length, extracted float values, and the raw byte data for debugging purposes.
+ * The transceiver is kept in receive mode and the UART reports every frame after a
+ * silence of about 3.5 characters (Modbus RTU frame gap). Requests and responses of
+ * another master are paired by handleSniffedFrame().
  *
- * The function assumes the response data is formatted in consecutive registers as 32-bit
- * floating-point values (two registers per value). Extracted values are stored in a local buffer.
+ * @note The other master defines the baud rate, so MODBUS_BAUD must match it.
+ */
+void LocalModbus::beginSniffer()
+{
+    // Prepare Hardware Serial.
+    RTUutils::prepareHardwareSerial(serial);
+
+    // Begin Second Serial Channel.
+    serial.begin(MODBUS_BAUD, SERIAL_8N1, MODBUS_RX, MODBUS_TX);
+
+    // Keep Transceiver in Receive Mode.
+    pinMode(MODBUS_RE, OUTPUT);
+    digitalWrite(MODBUS_RE, LOW);
+
+    // Split Frames on Silence (3 Symbols).
+    serial.setRxTimeout(3);
+    serial.onReceive(handleSniffedData, true);
+
+    // Print Debug Message.
+    Guardian::boot(55, "Sniffer");
+}
+
+/**
+ * @brief Reads a complete frame from the UART after the frame gap (UART task).
+ */
+void LocalModbus::handleSniffedData()
+{
+    size_t length = 0;
+
+    while (serial.available() > 0)
+    {
+        int value = serial.read();
+
+        // Drop Bytes of oversized Frames.
+        if (length < sizeof(sniffBuffer))
+            sniffBuffer[length++] = value;
+    }
+
+    handleSniffedFrame(sniffBuffer, length);
+}
+
+/**
+ * @brief Pairs sniffed requests and responses of another master.
  *
- * @param msg The Modbus message containing the response data from the queried device.
- *            It includes the server ID, function code, payload, etc.
- * @param token A unique identifier that corresponds to the triggered Modbus operation.
+ * Frames are checked with validChecksum(). A read input register request of a device
+ * of METER_DEVICES is remembered, and the matching response is split into registers
+ * exactly like a response to our own block request, so the bound setters of the
+ * Watcher and the MeterMirror receive the values.
  *
- * @return The first extracted float value from the response message payload.
+ * @param frame The raw RTU frame including the CRC.
+ * @param length The length of the frame.
+ */
+void LocalModbus::handleSniffedFrame(const uint8_t* frame, size_t length)
+{
+    // Smallest Frame is an Exception (ID / FC / Code / CRC).
+    if (length < 5)
+        return;
+
+    uint32_t token = ReadPlanner::toToken(sniffRequest);
+
+    if (!validChecksum(frame, length))
+    {
+        localStats.error(token, CRC_ERROR);
+        sniffPending = false;
+
+        return;
+    }
+
+    int8_t device = deviceOf(frame[0]);
+
+    if (device < 0)
+        return;
+
+    // Request (ID / FC / Address / Count / CRC).
+    if (frame[1] == READ_INPUT_REGISTER && length == 8)
+    {
+        sniffRequest = {
+            static_cast<uint16_t>(frame[2] << 8 | frame[3]), static_cast<uint16_t>(frame[4] << 8 | frame[5]),
+            static_cast<uint8_t>(device)
+        };
+        sniffSentAt = millis();
+        sniffPending = true;
+
+        localStats.request();
+        deviceStats[device].request();
+
+        return;
+    }
+
+    // Drop Responses of other Devices.
+    if (!sniffPending || device != sniffRequest.device)
+        return;
+
+    // Exception Response.
+    if (frame[1] == (READ_INPUT_REGISTER | 0x80))
+    {
+        localStats.error(token, static_cast<Error>(frame[2]));
+        deviceStats[device].error(token, static_cast<Error>(frame[2]));
+        sniffPending = false;
+
+        return;
+    }
+
+    // Response (ID / FC / Bytes / Data / CRC).
+    if (frame[1] == READ_INPUT_REGISTER && frame[2] == sniffRequest.length * 2 &&
+        length == MODBUS_OFFSET + sniffRequest.length * 2 + 2)
+    {
+        sniffPending = false;
+
+        localStats.response(token, millis() - sniffSentAt);
+        deviceStats[device].response(token, millis() - sniffSentAt);
+
+        // Wrap Frame without CRC.
+        ModbusMessage msg;
+        msg.add(frame, length - 2);
+
+        mirrorBlock(msg, token);
+
+        // Only the Meter of the Heater is bound to the Watcher.
+        if (device == 0)
+            dispatchBlock(msg, token, localBindings, LOCAL_BINDING_COUNT);
+    }
+}
+
+/**
+ * @brief Splits a block response into single registers and dispatches them.
+ *
+ * Every binding whose register is covered by the block is decoded in place from the
+ * response using its RegisterDescriptor and handed to the bound setter. The message is
+ * only read, no values are copied into intermediate buffers.
  *
- * @note The data in the message is accessed starting from a predefined offset. This assumes
- *       the message structure as per the device's implementation and protocol specifics.
+ * @param msg The Modbus message containing the block response.
+ * @param token The token of the block request (see ReadPlanner::toToken).
+ * @param bindings The register bindings of the client.
+ * @param count The count of register bindings.
  *
- * @warning The function makes use of fixed buffer sizes and assumes all required data is
- *          present in the Modbus response. Ensure the response matches the expected
- *          length and format to avoid memory access issues.
+ * @return true if at least one register was dispatched.
  */
-float LocalModbus::handleResponse(ModbusMessage& msg, uint32_t token)
+bool LocalModbus::dispatchBlock(const ModbusMessage& msg, uint32_t token, const RegisterBinding* bindings,
+                                uint8_t count)
 {
 #ifdef DEBUG
-            WebSerial.printf("Response: serverID=%d, FC=%d, Token=%08X, length=%d:\n", msg.getServerID(), msg.getFunctionCode(),
-                             token, msg.size());
+    WebSerial.printf("Response: serverID=%d, FC=%d, Token=%08X, length=%d:\n", msg.getServerID(), msg.getFunctionCode(),
+                     token, msg.size());
 #endif
 
-    // Add Float Buffer.
-    float values[REGISTER_LENGTH];
+    ReadPlanner::Block block = ReadPlanner::fromToken(token);
 
-    // First value is on pos 3, after server ID, function code and length byte
-    uint16_t offset = MODBUS_OFFSET;
+    // Check if Response covers the whole Block.
+    if (msg.size() < ReadPlanner::offsetOf(block, block.address + block.length))
+        return false;
 
-    // The device has values all as IEEE754 float32 in two consecutive registers
-    // Read the requested in a loop
-    for (uint8_t i = 0; i < REGISTER_LENGTH; ++i)
+    bool known = false;
+
+    for (uint8_t i = 0; i < count; i++)
     {
-        offset = msg.get(offset, values[i]);
-    }
+        const RegisterDescriptor* reg = findRegister(bindings[i].address, METER_DEVICES[block.device].map);
 
-#ifdef DEBUG
-        WebSerial.printf("Values: %f, %f\n", values[0], values[1]);
+        if (reg == nullptr || !ReadPlanner::contains(block, reg->address))
+            continue;
 
-        for (auto& byte : msg)
-        {
-            WebSerial.printf("%02X ", byte);
-        }
-#endif
+        // Decode in place.
+        float value = RegisterCodec::decode(msg.data() + ReadPlanner::offsetOf(block, reg->address), *reg);
 
+        bindings[i].apply(value);
+        known = true;
+    }
 
-    return values[0];
+    return known;
 }
 
 /**
- * @brief Handles and processes the received Modbus message data.
+ * @brief Caches every register of a local block response for the MeterMirror.
  *
- * This method extracts and displays information from the provided ModbusMessage, such as the server ID,
- * function code, data length, and the full message content in hexadecimal format. The information is
- * logged using the WebSerial interface for debugging or monitoring purposes.
+ * Unlike dispatchBlock() all registers of the register map of the device are cached, not
+ * only the bound ones. The first register of the map feeds the poll policy of the device.
  *
- * @param msg The ModbusMessage object containing the message data to be processed.
- * @param token A unique identifier associated with the request or transaction being processed.
+ * @param msg The Modbus message containing the block response.
+ * @param token The token of the block request (see ReadPlanner::toToken).
  */
-void LocalModbus::handleLocalData(ModbusMessage msg, uint32_t token)
+void LocalModbus::mirrorBlock(const ModbusMessage& msg, uint32_t token)
 {
-    float response = handleResponse(msg, token);
+    ReadPlanner::Block block = ReadPlanner::fromToken(token);
 
-    switch (token)
+    // Check if Response covers the whole Block.
+    if (msg.size() < ReadPlanner::offsetOf(block, block.address + block.length))
+        return;
+
+    if (block.device >= METER_DEVICE_COUNT)
+        return;
+
+    const RegisterMap& map = METER_DEVICES[block.device].map;
+
+    for (uint8_t i = 0; i < map.count; i++)
     {
-    case POWER_USAGE:
-        Watcher::setPower(response);
-        break;
-    case POWER_IMPORT:
-        Watcher::setConsumption(response);
-        break;
-    default:
-        unknownToken(token);
+        const RegisterDescriptor& reg = map.registers[i];
+
+        if (!ReadPlanner::contains(block, reg.address))
+            continue;
+
+        // Decode in place.
+        float value = RegisterCodec::decode(msg.data() + ReadPlanner::offsetOf(block, reg.address), reg);
+
+        MeterMirror::update(block.device, reg.address, value);
+
+        if (i == 0)
+            devicePolicies[block.device]->update(value);
+    }
+}
+
+/**
+ * @brief Handles and processes the received Modbus block response.
+ *
+ * Every register inside the block is cached for the MeterMirror. Blocks of the heater
+ * meter (first device) are additionally dispatched to the Watcher.
+ *
+ * @param msg The ModbusMessage object containing the block response.
+ * @param token The token of the block request (see ReadPlanner::toToken).
+ */
+void LocalModbus::handleLocalData(const ModbusMessage& msg, uint32_t token)
+{
+    // Response of the Baud Rate Negotiation.
+    if (BaudNegotiator::isToken(token))
+    {
+        BaudNegotiator::handleData(msg);
 
-        break;
+        return;
     }
+
+    // Release in-flight Slot and record RTT.
+    bool idle;
+    long rtt = localScheduler.complete(token, &idle);
+    long duration = stopWire(token);
+
+    if (duration >= 0)
+        localStats.wire(duration);
+
+    localStats.response(token, rtt);
+    deviceStatsOf(token).response(token, rtt);
+    localScheduler.confirm(token);
+
+    // Adapt Timeout (only to Requests sent to an idle Client, others were queued behind Blocks first).
+    if (rtt >= 0 && idle)
+        modbusRTU->setTimeout(estimateTimeout(localRtt, localStats, rtt));
+
+    // Cache all Registers for the Mirror.
+    mirrorBlock(msg, token);
+
+    // Only the Meter of the Heater is bound to the Watcher.
+    if (ReadPlanner::fromToken(token).device != 0)
+        return;
+
+    if (!dispatchBlock(msg, token, localBindings, LOCAL_BINDING_COUNT))
+        unknownToken(token);
 }
 
 /**
@@ -385,30 +1002,39 @@ void LocalModbus::unknownToken(uint32_t token)
 }
 
 /**
- * @brief Handles incoming Modbus messages and processes data based on a token identifier.
+ * @brief Handles incoming Modbus block responses of the house meter.
  *
- * This method processes a Modbus message received from a remote source by invoking
- * the `handleResponse` method to retrieve a floating-point response value. Based on
- * the token parameter, it performs specific actions, such as setting house power readings.
- * If the token is unrecognized, a diagnostic message is logged via the Guardian system.
+ * Every remotely bound register inside the block is decoded and dispatched to the
+ * Watcher. If the block does not contain a known register, a diagnostic message
+ * is logged via the Guardian system. Late responses of requests sent before the last
+ * reconnect are dropped, they would complete the request sent again.
  *
- * @param msg The ModbusMessage object representing the data received.
- * @param token A unique identifier specifying the type of data or action to be performed.
+ * @param msg The ModbusMessage object representing the block response.
+ * @param token The tagged token of the block request (see ModbusScheduler::tag).
  */
-void LocalModbus::handleRemoteData(ModbusMessage msg, uint32_t token)
+void LocalModbus::handleRemoteData(const ModbusMessage& msg, uint32_t token)
 {
-    float response = handleResponse(msg, token);
+    // Drop late Responses of Requests sent before the last Reconnect.
+    if (!remoteScheduler.isCurrent(token))
+        return;
 
-    switch (token)
-    {
-    case POWER_USAGE:
-        Watcher::setHousePower(response);
-        break;
-    default:
-        unknownToken(token);
+    token = ModbusScheduler::untag(token);
 
-        break;
-    }
+    TcpSupervisor::handleResponse();
+
+    // Release in-flight Slot and record RTT.
+    bool idle;
+    long rtt = remoteScheduler.complete(token, &idle);
+
+    remoteStats.response(token, rtt);
+    remoteScheduler.confirm(token);
+
+    // Adapt Timeout (only to Requests sent to an idle Client, others were queued behind Blocks first).
+    if (rtt >= 0 && idle)
+        modbusTCP->setTimeout(estimateTimeout(remoteRtt, remoteStats, rtt));
+
+    if (!dispatchBlock(msg, token, remoteBindings, REMOTE_BINDING_COUNT))
+        unknownToken(token);
 }
 
 
@@ -418,10 +1044,11 @@ void LocalModbus::handleRemoteData(ModbusMessage msg, uint32_t token)
  * This method sets up and starts the Modbus TCP client for communication. It configures
  * the target IP address, port, and other parameters required for Modbus TCP operation.
  * Additionally, it initializes the timeout setting for the associated ModbusRTU client.
+ * The connection itself (in-flight limit, probes and reconnects) is managed by the TcpSupervisor.
  * A debug message is logged to indicate the status of the initialization process.
  *
  * @note This function assumes predefined constants for IP address (MODBUS_TCP),
- * port (MODBUS_TCP_PORT), timeout (MODBUS_TIMEOUT), and core assignment (MODBUS_CORE).
+ * port (MODBUS_TCP_PORT), Server ID (MODBUS_TCP_SERVER_ID) and timeout (MODBUS_TIMEOUT_INITIAL).
  *
  * @attention Ensure network connectivity to the target Modbus TCP device before calling this method.
  */
@@ -431,16 +1058,16 @@ void LocalModbus::beginTCP()
     modbusTCP = new ModbusClientTCPasync(MODBUS_TCP, MODBUS_TCP_PORT);
 
     // Add Error Handler.
-    modbusTCP->onErrorHandler(handleResponseError);
+    modbusTCP->onErrorHandler(handleRemoteError);
 
-    // Add Message Handler.
+    // Add Message Handler (eModbus passes a Copy of the Response, the Handlers only read it from there on).
     modbusTCP->onDataHandler(handleRemoteData);
 
-    // Set Timeout.
-    modbusTCP->setTimeout(MODBUS_TIMEOUT);
+    // Set initial Timeout (adapted to the measured RTT afterward).
+    modbusTCP->setTimeout(remoteRtt.getTimeout());
 
     // Begin Modbus TCP Client.
-    modbusTCP->connect();
+    TcpSupervisor::begin(modbusTCP, &remoteScheduler);
 
     // Print Debug Message.
     Guardian::boot(60, "TCP");
@@ -7,7 +7,13 @@
 
 #include <Arduino.h>
 
+#include "ModbusClient.h"
 #include "ModbusMessage.h"
+#include "ModbusScheduler.h"
+#include "ModbusStats.h"
+#include "ReadPlanner.h"
+#include "RttEstimator.h"
+#include "TcpSupervisor.h"
 
 /**
  * @class LocalModbus
@@ -15,28 +21,60 @@
  * @brief Provides functionality for initializing and managing the Modbus communication.
  *
  * The Modbus class is designed to handle Modbus communication protocols.
- * It contains methods to initialize the communication and execute the
- * main loop for processing messages or tasks related to Modbus.
+ * It contains methods to initialize the communication and to flush the wanted
+ * registers as block requests with every control step.
  */
 class LocalModbus
 {
 public:
     static void begin();
-    static void loop();
-    static float readRemote(int address);
+    static void flush();
+    static bool readRemote(int address);
     static bool readLocal(int address);
     static long getQueueTCP();
     static long getQueueRTU();
+    static ModbusStats::Summary getStatsRTU();
+    static const char* getRS485Mode();
+    static uint32_t getBaudRate();
+    static ModbusStats::Summary getStatsTCP();
+    static ModbusStats::Summary getStatsDevice(uint8_t device);
+    static TcpSupervisor::Summary getLinkTCP();
+    static void reconnectTCP();
+
+    /**
+     * @struct RegisterBinding
+     * @brief Binds a register of the register map to the setter which receives its value.
+     */
+    struct RegisterBinding
+    {
+        uint16_t address;
+        void (*apply)(float value);
+    };
 
 private:
+    static void handlePolling();
+    static bool isBound(uint16_t address, const RegisterBinding* bindings, uint8_t count);
     static void handleReadMessage(String str, int address);
     static void handleRequestError(Error error);
     static void handleResponseError(Error error, uint32_t token);
     static void beginRTU();
-    static float handleResponse(ModbusMessage& msg, uint32_t token);
-    static void handleLocalData(ModbusMessage msg, uint32_t token);
+    static void beginSniffer();
+    static void handleSniffedData();
+    static void handleSniffedFrame(const uint8_t* frame, size_t length);
+    static bool requestBlock(ModbusClient* client, ModbusScheduler& scheduler, ModbusStats& stats,
+                             const ReadPlanner::Block& block, uint8_t serverID);
+    static void startWire(uint32_t token);
+    static long stopWire(uint32_t token);
+    static void handleLocalError(Error error, uint32_t token);
+    static void handleRemoteError(Error error, uint32_t token);
+    static ModbusStats& deviceStatsOf(uint32_t token);
+    static uint32_t estimateTimeout(RttEstimator& estimator, ModbusStats& stats, long rtt);
+    static bool dispatchBlock(const ModbusMessage& msg, uint32_t token, const RegisterBinding* bindings,
+                              uint8_t count);
+    static void mirrorBlock(const ModbusMessage& msg, uint32_t token);
+    static void handleLocalData(const ModbusMessage& msg, uint32_t token);
     static void unknownToken(uint32_t token);
-    static void handleRemoteData(ModbusMessage msg, uint32_t token);
+    static void handleRemoteData(const ModbusMessage& msg, uint32_t token);
     static void beginTCP();
     static bool validChecksum(const uint8_t* data, size_t messageLength);
     static uint16_t calculateCRC(const uint8_t* array, uint8_t len);
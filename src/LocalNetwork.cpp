@@ -9,9 +9,14 @@
 
 #include <WebServer.h>
 
+#include "ControlTask.h"
 #include "ElegantOTA.h"
 #include "PinOut.h"
 #include "Guardian.h"
+#include "HousePower.h"
+#include "LocalModbus.h"
+#include "MeterMirror.h"
+#include "MeterRegisters.h"
 #include "Watcher.h"
 
 #ifdef DEBUG
@@ -92,6 +97,215 @@ void LocalNetwork::handleSerial()
 #endif
 }
 
+/**
+ * @brief Registers the HTTP endpoint of the Modbus statistics.
+ *
+ * GET /modbus returns request rate, RTT percentiles and error counters of the RTU and
+ * TCP client, of every device on the RTU bus and of the TCP connection as JSON, and the
+ * wire time of RTU transactions in µs.
+ */
+void LocalNetwork::handleStats()
+{
+    server.on("/modbus", HTTP_GET, [](AsyncWebServerRequest* request)
+    {
+        char buffer[800 + 200 * METER_DEVICE_COUNT];
+        ModbusStats::Summary stats[] = {LocalModbus::getStatsRTU(), LocalModbus::getStatsTCP()};
+        const char* names[] = {"rtu", "tcp"};
+        int length = snprintf(buffer, sizeof(buffer),
+                              "{\"rs485\":\"%s\",\"baud\":%u,\"wire\":{\"count\":%u,\"min\":%u,\"mean\":%u,"
+                              "\"max\":%u}", LocalModbus::getRS485Mode(), LocalModbus::getBaudRate(),
+                              stats[0].wireCount, stats[0].wireMin, stats[0].wireMean, stats[0].wireMax);
+
+        for (uint8_t i = 0; i < 2; i++)
+        {
+            length += snprintf(buffer + length, sizeof(buffer) - length,
+                               ",\"%s\":{\"requests\":%u,\"responses\":%u,\"timeouts\":%u,\"crc\":%u,"
+                               "\"exceptions\":%u,\"other\":%u,\"retries\":%u,\"rate\":%.2f,\"p50\":%u,\"p95\":%u,"
+                               "\"p99\":%u,\"srtt\":%u,\"timeout\":%u}",
+                               names[i], stats[i].requests, stats[i].responses, stats[i].timeouts,
+                               stats[i].crcErrors, stats[i].exceptions, stats[i].otherErrors, stats[i].retries,
+                               stats[i].rate, stats[i].p50, stats[i].p95, stats[i].p99, stats[i].srtt,
+                               stats[i].timeout);
+        }
+
+        length += snprintf(buffer + length, sizeof(buffer) - length, ",\"devices\":[");
+
+        for (uint8_t i = 0; i < METER_DEVICE_COUNT; i++)
+        {
+            ModbusStats::Summary device = LocalModbus::getStatsDevice(i);
+
+            length += snprintf(buffer + length, sizeof(buffer) - length,
+                               "%s{\"id\":%u,\"requests\":%u,\"responses\":%u,\"timeouts\":%u,\"crc\":%u,"
+                               "\"exceptions\":%u,\"other\":%u,\"rate\":%.2f,\"p50\":%u,\"p95\":%u,\"p99\":%u}",
+                               (i > 0 ? "," : ""), METER_DEVICES[i].serverID, device.requests, device.responses,
+                               device.timeouts, device.crcErrors, device.exceptions, device.otherErrors, device.rate,
+                               device.p50, device.p95, device.p99);
+        }
+
+        TcpSupervisor::Summary link = LocalModbus::getLinkTCP();
+
+        length += snprintf(buffer + length, sizeof(buffer) - length,
+                           "],\"link\":{\"state\":\"%s\",\"reconnects\":%u,\"probes\":%u,\"inflight\":%u,"
+                           "\"maxInflight\":%u,\"backoff\":%u}",
+                           TcpSupervisor::getStateName(link.state), link.reconnects, link.probes, link.inFlight,
+                           link.maxInFlight, link.backoff);
+
+        snprintf(buffer + length, sizeof(buffer) - length, ",\"mirror\":{\"requests\":%u,\"clients\":%u}}",
+                 MeterMirror::getRequests(), MeterMirror::getClients());
+
+        request->send(200, "application/json", buffer);
+    });
+}
+
+/**
+ * @brief Registers the HTTP endpoint of the house power sources.
+ *
+ * GET /house returns the active source and the value, age and measured update interval
+ * of every enabled source as JSON. The power of each phase (W) and the exported energy
+ * (kWh) of the Modbus TCP meter follow under "phases" and "export", null if never read.
+ */
+void LocalNetwork::handleHouse()
+{
+    server.on("/house", HTTP_GET, [](AsyncWebServerRequest* request)
+    {
+        char buffer[520];
+        HouseSource* active = HousePower::getActive();
+        int length = snprintf(buffer, sizeof(buffer), "{\"active\":\"%s\",\"sources\":[",
+                              active != nullptr ? active->getName() : "");
+
+        for (uint8_t i = 0; i < HousePower::getCount(); i++)
+        {
+            HouseSource* source = HousePower::getSource(i);
+            unsigned long age = source->getAge();
+
+            length += snprintf(buffer + length, sizeof(buffer) - length,
+                               "%s{\"name\":\"%s\",\"value\":%.1f,\"age\":%ld,\"interval\":%lu,\"updates\":%u}",
+                               (i > 0 ? "," : ""), source->getName(), source->get().value,
+                               (age == ULONG_MAX ? -1L : static_cast<long>(age)), source->getInterval(),
+                               source->getUpdates());
+        }
+
+        length += snprintf(buffer + length, sizeof(buffer) - length, "],\"phases\":[");
+
+        for (uint8_t i = 0; i < 3; i++)
+        {
+            MeterSample::Snapshot phase = HousePower::getPhase(i);
+
+            if (phase.sequence > 0)
+                length += snprintf(buffer + length, sizeof(buffer) - length, "%s%.1f", (i > 0 ? "," : ""), phase.value);
+            else
+                length += snprintf(buffer + length, sizeof(buffer) - length, "%snull", (i > 0 ? "," : ""));
+        }
+
+        MeterSample::Snapshot exported = HousePower::getExport();
+
+        if (exported.sequence > 0)
+            snprintf(buffer + length, sizeof(buffer) - length, "],\"export\":%.3f}", exported.value);
+        else
+            snprintf(buffer + length, sizeof(buffer) - length, "],\"export\":null}");
+
+        request->send(200, "application/json", buffer);
+    });
+}
+
+/**
+ * @brief Registers the HTTP endpoint of the control loop.
+ *
+ * GET /control returns the count of event and watchdog steps and the last, smoothed and
+ * max. latency from a fresh house power sample to the applied duty in ms as JSON. With
+ * CONTROL_TASK the ticks, overruns, the last, smoothed and max. period jitter and the max.
+ * runtime of the control task in us follow under "task".
+ */
+void LocalNetwork::handleControl()
+{
+    server.on("/control", HTTP_GET, [](AsyncWebServerRequest* request)
+    {
+        char buffer[320];
+        ControlTrigger::Summary control = Watcher::getControlSummary();
+
+        int length = snprintf(buffer, sizeof(buffer),
+                              "{\"events\":%u,\"watchdogs\":%u,\"latency\":%u,\"average\":%u,\"max\":%u",
+                              control.events, control.watchdogs, control.latency, control.average, control.maximum);
+
+#if CONTROL_TASK
+        ControlTask::Summary task = ControlTask::getSummary();
+
+        length += snprintf(buffer + length, sizeof(buffer) - length,
+                           ",\"task\":{\"ticks\":%u,\"overruns\":%u,\"jitter\":%u,\"average\":%u,\"max\":%u,"
+                           "\"runtime\":%u}", task.ticks, task.overruns, task.jitter, task.average, task.maximum,
+                           task.runtime);
+#endif
+
+        snprintf(buffer + length, sizeof(buffer) - length, "}");
+
+        request->send(200, "application/json", buffer);
+    });
+}
+
+/**
+ * @brief Registers the HTTP endpoint of the learned power curve.
+ *
+ * GET /power returns the mean duty, power and sample count of every learned bin of the
+ * duty to power curve of the heater as JSON.
+ */
+void LocalNetwork::handlePower()
+{
+    server.on("/power", HTTP_GET, [](AsyncWebServerRequest* request)
+    {
+        char buffer[40 + 60 * POWER_BINS];
+        const PowerModel& model = Watcher::getPowerModel();
+        int length = snprintf(buffer, sizeof(buffer), "{\"samples\":%u,\"bins\":[", model.getSamples());
+        bool first = true;
+
+        for (uint8_t i = 0; i < POWER_BINS; i++)
+        {
+            const PowerModel::Bin& bin = model.getBin(i);
+
+            if (bin.samples == 0)
+                continue;
+
+            length += snprintf(buffer + length, sizeof(buffer) - length,
+                               "%s{\"bin\":%u,\"duty\":%.1f,\"power\":%.1f,\"samples\":%u}", (first ? "" : ","), i,
+                               bin.duty, bin.power, bin.samples);
+            first = false;
+        }
+
+        snprintf(buffer + length, sizeof(buffer) - length, "]}");
+
+        request->send(200, "application/json", buffer);
+    });
+}
+
+/**
+ * @brief Registers the HTTP endpoint of the heater channels.
+ *
+ * GET /channels returns the capacity of the allocator and the phase, priority, duty,
+ * relay state and estimated power of every heater channel as JSON.
+ */
+void LocalNetwork::handleChannels()
+{
+    server.on("/channels", HTTP_GET, [](AsyncWebServerRequest* request)
+    {
+        char buffer[40 + 90 * ALLOCATOR_CHANNELS];
+        const PowerAllocator& allocator = Watcher::getAllocator();
+        int length = snprintf(buffer, sizeof(buffer), "{\"capacity\":%u,\"channels\":[", allocator.getCapacity());
+
+        for (uint8_t i = 0; i < allocator.getCount(); i++)
+        {
+            const HeaterChannel& channel = allocator.getChannel(i);
+
+            length += snprintf(buffer + length, sizeof(buffer) - length,
+                               "%s{\"phase\":%u,\"priority\":%u,\"duty\":%u,\"enabled\":%s,\"power\":%.1f}",
+                               (i == 0 ? "" : ","), channel.getConfig().phase, channel.getConfig().priority,
+                               channel.getDuty(), (channel.isEnabled() ? "true" : "false"), channel.getPower());
+        }
+
+        snprintf(buffer + length, sizeof(buffer) - length, "]}");
+
+        request->send(200, "application/json", buffer);
+    });
+}
+
 /**
  * @brief Initializes the network connection and attempts to establish a connection with DHCP.
  *
@@ -153,6 +367,21 @@ void LocalNetwork::begin()
     // Setup WebSerial.
     handleSerial();
 
+    // Setup Modbus Statistics Endpoint.
+    handleStats();
+
+    // Setup House Power Sources Endpoint.
+    handleHouse();
+
+    // Setup Control Loop Endpoint.
+    handleControl();
+
+    // Setup Power Curve Endpoint.
+    handlePower();
+
+    // Setup Heater Channels Endpoint.
+    handleChannels();
+
     // Print Debug Message.
     Guardian::println("OTA is ready");
 }
@@ -273,4 +502,7 @@ void LocalNetwork::reconf()
 
     // Recreate Connection.
     reconnect();
+
+    // Drop dead Modbus TCP Socket.
+    LocalModbus::reconnectTCP();
 }
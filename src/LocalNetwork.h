@@ -19,6 +19,11 @@ class LocalNetwork
 private:
     static void handleOTA();
     static void handleSerial();
+    static void handleStats();
+    static void handleHouse();
+    static void handleControl();
+    static void handlePower();
+    static void handleChannels();
     static uint8_t mac[6];  // Speicher für die MAC-Adresse
     static char macStr[18]; // Für die String-Repräsentation (XX:XX:XX:XX:XX:XX\0)
 
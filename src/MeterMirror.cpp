@@ -0,0 +1,183 @@
+//
+// Created by JanHe on 16.10.2026.
+//
+
+#include "MeterMirror.h"
+
+#include "Guardian.h"
+#include "MeterRegisters.h"
+#include "MeterSample.h"
+#include "ModbusServerTCPasync.h"
+#include "PinOut.h"
+#include "RegisterCodec.h"
+
+// Max. Registers of a single Read (Modbus Limit).
+#define MIRROR_MAX_WORDS 125
+
+// Age of a Register in Seconds.
+constexpr RegisterDescriptor AGE_REGISTER = {0, 2, RegisterType::FLOAT32, WordOrder::HIGH_FIRST, 1.0F};
+
+// Store Modbus TCP Server Instance.
+ModbusServerTCPasync mirrorServer;
+
+// Store cached Samples by Device and Index of its Register Map.
+MeterSample mirrorSamples[METER_DEVICE_COUNT][REGISTER_COUNT];
+
+// Store Count of served Requests.
+uint32_t mirrorRequests = 0;
+
+
+/**
+ * @brief Starts the Modbus TCP server of the mirror.
+ *
+ * The server answers input register reads of every device of METER_DEVICES under its
+ * Server ID on MIRROR_PORT.
+ */
+void MeterMirror::begin()
+{
+    for (uint8_t i = 0; i < METER_DEVICE_COUNT; i++)
+    {
+        mirrorServer.registerWorker(METER_DEVICES[i].serverID, READ_INPUT_REGISTER, &handleReadInput);
+    }
+
+    mirrorServer.start(MIRROR_PORT, MIRROR_CLIENTS, MIRROR_TIMEOUT);
+
+    // Print Debug Message.
+    Guardian::boot(65, "Mirror");
+}
+
+/**
+ * @brief Caches a register value read from a local meter.
+ *
+ * @param device The index of the device (see METER_DEVICES).
+ * @param address The start address of the register.
+ * @param value The decoded value.
+ */
+void MeterMirror::update(uint8_t device, uint16_t address, float value)
+{
+    if (device >= METER_DEVICE_COUNT)
+        return;
+
+    const RegisterMap& map = METER_DEVICES[device].map;
+
+    for (uint8_t i = 0; i < min(map.count, static_cast<uint8_t>(REGISTER_COUNT)); i++)
+    {
+        if (map.registers[i].address == address)
+        {
+            mirrorSamples[device][i].update(value);
+
+            return;
+        }
+    }
+}
+
+/**
+ * @brief Retrieves the count of served read requests.
+ *
+ * @return The count of requests.
+ */
+uint32_t MeterMirror::getRequests()
+{
+    return mirrorRequests;
+}
+
+/**
+ * @brief Retrieves the count of connected TCP clients.
+ *
+ * @return The count of clients.
+ */
+uint32_t MeterMirror::getClients()
+{
+    return mirrorServer.activeClients();
+}
+
+/**
+ * @brief Answers an input register read from the cache (server task).
+ *
+ * Every word of the requested range must belong to a mirrored register or its age
+ * register and no register may be split, otherwise ILLEGAL_DATA_ADDRESS is returned
+ * like the meter does. So a client never mistakes a filler for a reading, registers
+ * which were never read are served as NaN. The device is selected by the Server ID of
+ * the request.
+ *
+ * @param request The read request.
+ *
+ * @return The response containing the requested registers.
+ */
+ModbusMessage MeterMirror::handleReadInput(ModbusMessage request)
+{
+    ModbusMessage response;
+    uint16_t address;
+    uint16_t words;
+
+    request.get(2, address);
+    request.get(4, words);
+
+    int8_t device = deviceOf(request.getServerID());
+
+    if (device < 0 || words == 0 || words > MIRROR_MAX_WORDS)
+    {
+        response.setError(request.getServerID(), request.getFunctionCode(), ILLEGAL_DATA_VALUE);
+
+        return response;
+    }
+
+    uint8_t data[MIRROR_MAX_WORDS * 2] = {};
+    uint32_t end = static_cast<uint32_t>(address) + words;
+    uint32_t covered = 0;
+
+    const RegisterMap& map = METER_DEVICES[device].map;
+
+    for (uint8_t i = 0; i < min(map.count, static_cast<uint8_t>(REGISTER_COUNT)); i++)
+    {
+        const RegisterDescriptor& reg = map.registers[i];
+        MeterSample::Snapshot sample = mirrorSamples[device][i].get();
+
+        // Value and Age of the Register.
+        uint32_t starts[] = {reg.address, static_cast<uint32_t>(reg.address) + MIRROR_AGE_OFFSET};
+        float values[] = {NAN, NAN};
+
+        if (sample.sequence > 0)
+        {
+            values[0] = sample.value;
+            values[1] = (millis() - sample.timestamp) / 1000.0F;
+        }
+
+        for (uint8_t j = 0; j < 2; j++)
+        {
+            const RegisterDescriptor& format = (j == 0 ? reg : AGE_REGISTER);
+            uint32_t last = starts[j] + format.words;
+
+            // Skip Registers outside the Range.
+            if (last <= address || starts[j] >= end)
+                continue;
+
+            // Reject split Registers.
+            if (starts[j] < address || last > end)
+            {
+                response.setError(request.getServerID(), request.getFunctionCode(), ILLEGAL_DATA_ADDRESS);
+
+                return response;
+            }
+
+            RegisterCodec::encode(values[j], data + (starts[j] - address) * 2, format);
+            covered += format.words;
+        }
+    }
+
+    // Reject Ranges with unmirrored Registers.
+    if (covered != words)
+    {
+        response.setError(request.getServerID(), request.getFunctionCode(), ILLEGAL_DATA_ADDRESS);
+
+        return response;
+    }
+
+    response.add(request.getServerID(), request.getFunctionCode(), static_cast<uint8_t>(words * 2));
+    response.add(data, words * 2);
+
+    mirrorRequests++;
+
+    return response;
+}
+
@@ -0,0 +1,36 @@
+//
+// Created by JanHe on 16.10.2026.
+//
+
+#ifndef METERMIRROR_H
+#define METERMIRROR_H
+
+#include <Arduino.h>
+
+#include "ModbusMessage.h"
+
+
+/**
+ * @class MeterMirror
+ * @brief Serves the cached registers of the local meters via Modbus TCP.
+ *
+ * Every register of the devices in METER_DEVICES which was read by the firmware is cached
+ * together with its acquisition time. Other consumers on the network read the same input
+ * registers (FC 0x04) under the Server ID of the device from the mirror instead of the
+ * meter, so they never compete with LocalModbus on the RTU bus. The age of register X in seconds is served as float32 at
+ * X + MIRROR_AGE_OFFSET. Registers which were never read are served as NaN.
+ */
+class MeterMirror
+{
+public:
+    static void begin();
+    static void update(uint8_t device, uint16_t address, float value);
+    static uint32_t getRequests();
+    static uint32_t getClients();
+
+private:
+    static ModbusMessage handleReadInput(ModbusMessage request);
+};
+
+
+#endif //METERMIRROR_H
@@ -5,9 +5,178 @@
 #ifndef METERREGISTERS_H
 #define METERREGISTERS_H
 
+#include <stdint.h>
+
 // 1 Register equals 16 bit => 2x16 bit => 32bit => float32.
 #define REGISTER_LENGTH 2
+#define PHASE_1_POWER 0x000C // => 12
+#define PHASE_2_POWER 0x000E // => 14
+#define PHASE_3_POWER 0x0010 // => 16
 #define POWER_USAGE 0x0034 // => 52
 #define POWER_IMPORT 0x0048 // => 72
+#define POWER_EXPORT 0x004A // => 74
+#define BAUD_RATE 0x001C // => 28 (Holding Register, 0=2400, 1=4800, 2=9600, 3=19200, 4=38400)
+
+// Max. Registers which can be planned at once.
+#define REGISTER_COUNT 8
+
+/**
+ * @enum RegisterType
+ * @brief Data type of a meter register.
+ */
+enum class RegisterType : uint8_t
+{
+    FLOAT32, UINT16, INT16, UINT32, INT32
+};
+
+/**
+ * @enum WordOrder
+ * @brief Order of the 16 bit words of a 32 bit register (Eastron uses HIGH_FIRST).
+ */
+enum class WordOrder : uint8_t
+{
+    HIGH_FIRST, LOW_FIRST
+};
+
+/**
+ * @struct RegisterDescriptor
+ * @brief Describes how a single meter register is read and decoded.
+ */
+struct RegisterDescriptor
+{
+    uint16_t address;
+    uint8_t words;
+    RegisterType type;
+    WordOrder order;
+    float scale;
+};
+
+// Register Map of the Eastron SDM Meters (Address / Words / Type / Word Order / Scale).
+// A new Register needs its Address above and an Entry here, it is then polled on the RTU Bus and mirrored. Only if
+// the Watcher uses the Value, it also needs a Binding to a Setter (localBindings / remoteBindings in LocalModbus.cpp).
+constexpr RegisterDescriptor METER_REGISTERS[] = {
+    {PHASE_1_POWER, 2, RegisterType::FLOAT32, WordOrder::HIGH_FIRST, 1.0F},
+    {PHASE_2_POWER, 2, RegisterType::FLOAT32, WordOrder::HIGH_FIRST, 1.0F},
+    {PHASE_3_POWER, 2, RegisterType::FLOAT32, WordOrder::HIGH_FIRST, 1.0F},
+    {POWER_USAGE, 2, RegisterType::FLOAT32, WordOrder::HIGH_FIRST, 1.0F},
+    {POWER_IMPORT, 2, RegisterType::FLOAT32, WordOrder::HIGH_FIRST, 1.0F},
+    {POWER_EXPORT, 2, RegisterType::FLOAT32, WordOrder::HIGH_FIRST, 1.0F},
+};
+
+// Network Baud Rate of the Eastron SDM Meters (Holding Register, not polled).
+constexpr RegisterDescriptor BAUD_REGISTER = {BAUD_RATE, 2, RegisterType::FLOAT32, WordOrder::HIGH_FIRST, 1.0F};
+
+constexpr uint8_t METER_REGISTER_COUNT = sizeof(METER_REGISTERS) / sizeof(RegisterDescriptor);
+
+/**
+ * @struct RegisterMap
+ * @brief The registers of a single meter type.
+ */
+struct RegisterMap
+{
+    const RegisterDescriptor* registers;
+    uint8_t count;
+};
+
+/**
+ * @struct MeterDevice
+ * @brief A meter on the RTU bus (Server ID, register map and poll policy of its registers).
+ *
+ * The first register of the map drives the poll policy (see PollPolicy).
+ */
+struct MeterDevice
+{
+    uint8_t serverID;
+    RegisterMap map;
+    unsigned long minInterval;
+    unsigned long maxInterval;
+    float threshold;
+};
+
+// Meters on the RTU Bus (Server ID / Register Map / Min. Interval / Max. Interval / Threshold).
+// The first one is the Meter of the Heater, further ones (e.g. Sub-Meters of other Heating Circuits) are
+// polled round-robin on the same Bus and served by the Mirror under their Server ID.
+constexpr MeterDevice METER_DEVICES[] = {
+    {1, {METER_REGISTERS, METER_REGISTER_COUNT}, 1000, 10000, 50.0F},
+};
+
+constexpr uint8_t METER_DEVICE_COUNT = sizeof(METER_DEVICES) / sizeof(MeterDevice);
+
+/**
+ * @brief Looks up the descriptor of a register in a register map.
+ *
+ * @param address The start address of the register.
+ * @param map The register map of the meter.
+ *
+ * @return The descriptor or nullptr if the register is unknown.
+ */
+constexpr const RegisterDescriptor* findRegister(uint16_t address, const RegisterMap& map)
+{
+    for (uint8_t i = 0; i < map.count; i++)
+    {
+        if (map.registers[i].address == address)
+            return &map.registers[i];
+    }
+
+    return nullptr;
+}
+
+/**
+ * @brief Looks up the descriptor of a register in the register map of the first device.
+ *
+ * @param address The start address of the register.
+ *
+ * @return The descriptor or nullptr if the register is unknown.
+ */
+constexpr const RegisterDescriptor* findRegister(uint16_t address)
+{
+    return findRegister(address, METER_DEVICES[0].map);
+}
+
+/**
+ * @brief Retrieves the count of 16 bit words of a register.
+ *
+ * @param address The start address of the register.
+ * @param map The register map of the meter.
+ *
+ * @return The words of the register, or REGISTER_LENGTH if the register is unknown.
+ */
+constexpr uint8_t wordsOf(uint16_t address, const RegisterMap& map)
+{
+    return findRegister(address, map) != nullptr ? findRegister(address, map)->words : REGISTER_LENGTH;
+}
+
+/**
+ * @brief Retrieves the count of 16 bit words of a register of the first device.
+ *
+ * @param address The start address of the register.
+ *
+ * @return The words of the register, or REGISTER_LENGTH if the register is unknown.
+ */
+constexpr uint8_t wordsOf(uint16_t address)
+{
+    return wordsOf(address, METER_DEVICES[0].map);
+}
+
+/**
+ * @brief Finds the device of a Server ID.
+ *
+ * @param serverID The Server ID on the RTU bus.
+ *
+ * @return The index of the device (see METER_DEVICES), or -1 if the Server ID is unknown.
+ */
+constexpr int8_t deviceOf(uint8_t serverID)
+{
+    for (uint8_t i = 0; i < METER_DEVICE_COUNT; i++)
+    {
+        if (METER_DEVICES[i].serverID == serverID)
+            return i;
+    }
+
+    return -1;
+}
+
+static_assert(wordsOf(POWER_USAGE) == REGISTER_LENGTH, "POWER_USAGE must be a float32 register");
+static_assert(METER_DEVICE_COUNT > 0 && METER_DEVICE_COUNT <= 0x10, "METER_DEVICES must fit into the Token");
 
 #endif //METERREGISTERS_H
@@ -0,0 +1,79 @@
+//
+// Created by JanHe on 16.10.2026.
+//
+
+#include "MeterSample.h"
+
+/**
+ * @brief Stores a new value and stamps it with the current time.
+ *
+ * @param value The decoded meter value.
+ */
+void MeterSample::update(float value)
+{
+    unsigned long now = millis();
+
+    portENTER_CRITICAL(&mux);
+    sample.value = value;
+    sample.timestamp = now;
+    sample.sequence++;
+    portEXIT_CRITICAL(&mux);
+}
+
+/**
+ * @brief Stores a value which was acquired earlier, e.g. from a state snapshot.
+ *
+ * @param value The meter value.
+ * @param age The age of the value in ms.
+ */
+void MeterSample::restore(float value, unsigned long age)
+{
+    unsigned long now = millis();
+
+    portENTER_CRITICAL(&mux);
+    sample.value = value;
+    sample.timestamp = now - age;
+    sample.sequence++;
+    portEXIT_CRITICAL(&mux);
+}
+
+/**
+ * @brief Retrieves a consistent copy of value, timestamp and sequence number.
+ *
+ * @return The snapshot of the sample.
+ */
+MeterSample::Snapshot MeterSample::get()
+{
+    portENTER_CRITICAL(&mux);
+    Snapshot copy = sample;
+    portEXIT_CRITICAL(&mux);
+
+    return copy;
+}
+
+/**
+ * @brief Retrieves the time since the value was acquired.
+ *
+ * @return The age in ms, or ULONG_MAX if no value was received yet.
+ */
+unsigned long MeterSample::getAge()
+{
+    Snapshot copy = get();
+
+    if (copy.sequence == 0)
+        return ULONG_MAX;
+
+    return millis() - copy.timestamp;
+}
+
+/**
+ * @brief Checks if the value is too old to be used by the controller.
+ *
+ * @param maxAge The max. allowed age in ms.
+ *
+ * @return true if no value was received yet or the value is older than maxAge.
+ */
+bool MeterSample::isStale(unsigned long maxAge)
+{
+    return getAge() > maxAge;
+}
@@ -0,0 +1,47 @@
+//
+// Created by JanHe on 16.10.2026.
+//
+
+#ifndef METERSAMPLE_H
+#define METERSAMPLE_H
+
+#include <Arduino.h>
+#include <climits>
+
+
+/**
+ * @class MeterSample
+ * @brief A single meter value together with its acquisition time and sequence number.
+ *
+ * Samples are written from the Modbus client task and read from the control loop,
+ * so all access is guarded by a critical section. The sequence number is increased
+ * with every new value, which allows the controller to detect whether it already
+ * acted on a value.
+ */
+class MeterSample
+{
+public:
+    /**
+     * @struct Snapshot
+     * @brief A consistent copy of the sample.
+     */
+    struct Snapshot
+    {
+        float value;
+        unsigned long timestamp;
+        uint32_t sequence;
+    };
+
+    void update(float value);
+    void restore(float value, unsigned long age);
+    Snapshot get();
+    unsigned long getAge();
+    bool isStale(unsigned long maxAge);
+
+private:
+    Snapshot sample = {0.0F, 0, 0};
+    portMUX_TYPE mux = portMUX_INITIALIZER_UNLOCKED;
+};
+
+
+#endif //METERSAMPLE_H
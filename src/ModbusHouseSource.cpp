@@ -0,0 +1,93 @@
+//
+// Created by JanHe on 16.10.2026.
+//
+
+#include "ModbusHouseSource.h"
+
+#include "LocalModbus.h"
+#include "MeterRegisters.h"
+
+/**
+ * @brief Constructs the Modbus TCP source.
+ *
+ * @param minInterval The shortest polling interval in ms.
+ * @param maxInterval The longest polling interval in ms.
+ * @param threshold The change between two reads which counts as fast change.
+ */
+ModbusHouseSource::ModbusHouseSource(unsigned long minInterval, unsigned long maxInterval, float threshold) :
+    HouseSource("modbus"), policy(minInterval, maxInterval, threshold)
+{
+}
+
+/**
+ * @brief Wants the power, phase and export registers of the house meter if the poll
+ * policy is due.
+ */
+void ModbusHouseSource::poll()
+{
+    if (!policy.isDue())
+        return;
+
+    LocalModbus::readRemote(POWER_USAGE);
+    LocalModbus::readRemote(PHASE_1_POWER);
+    LocalModbus::readRemote(PHASE_2_POWER);
+    LocalModbus::readRemote(PHASE_3_POWER);
+    LocalModbus::readRemote(POWER_EXPORT);
+}
+
+/**
+ * @brief Receives the decoded power register (Modbus TCP client task).
+ *
+ * @param value The house power in W.
+ */
+void ModbusHouseSource::handleValue(float value)
+{
+    // Adapt Polling Interval.
+    policy.update(value);
+
+    update(value);
+}
+
+/**
+ * @brief Receives the decoded power register of a phase (Modbus TCP client task).
+ *
+ * @param phase The index of the phase (0-2).
+ * @param value The power of the phase in W.
+ */
+void ModbusHouseSource::handlePhase(uint8_t phase, float value)
+{
+    if (phase < 3)
+        phases[phase].update(value);
+}
+
+/**
+ * @brief Receives the decoded export energy register (Modbus TCP client task).
+ *
+ * @param value The exported energy in kWh.
+ */
+void ModbusHouseSource::handleExport(float value)
+{
+    exported.update(value);
+}
+
+/**
+ * @brief Retrieves the last power of a phase.
+ *
+ * @param phase The index of the phase (0-2).
+ *
+ * @return The sample, sequence 0 if never read.
+ */
+MeterSample::Snapshot ModbusHouseSource::getPhase(uint8_t phase)
+{
+    return phases[phase < 3 ? phase : 0].get();
+}
+
+/**
+ * @brief Retrieves the last exported energy.
+ *
+ * @return The sample, sequence 0 if never read.
+ */
+MeterSample::Snapshot ModbusHouseSource::getExport()
+{
+    return exported.get();
+}
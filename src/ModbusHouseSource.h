@@ -0,0 +1,40 @@
+//
+// Created by JanHe on 16.10.2026.
+//
+
+#ifndef MODBUSHOUSESOURCE_H
+#define MODBUSHOUSESOURCE_H
+
+#include "HouseSource.h"
+#include "MeterSample.h"
+#include "PollPolicy.h"
+
+
+/**
+ * @class ModbusHouseSource
+ * @brief Reads the house power from the Modbus TCP meter (MODBUS_TCP).
+ *
+ * The POWER_USAGE register is wanted via LocalModbus::readRemote() according to a
+ * PollPolicy, the value arrives from the Modbus TCP client task. The power of each phase
+ * and the exported energy are wanted together with it, their blocks are pipelined on the
+ * socket and arrive within the same round trip.
+ */
+class ModbusHouseSource : public HouseSource
+{
+public:
+    ModbusHouseSource(unsigned long minInterval, unsigned long maxInterval, float threshold);
+    void poll() override;
+    void handleValue(float value);
+    void handlePhase(uint8_t phase, float value);
+    void handleExport(float value);
+    MeterSample::Snapshot getPhase(uint8_t phase);
+    MeterSample::Snapshot getExport();
+
+private:
+    PollPolicy policy;
+    MeterSample phases[3];
+    MeterSample exported;
+};
+
+
+#endif //MODBUSHOUSESOURCE_H
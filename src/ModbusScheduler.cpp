@@ -0,0 +1,464 @@
+//
+// Created by JanHe on 16.10.2026.
+//
+
+#include "ModbusScheduler.h"
+
+/**
+ * @brief Constructs a scheduler with the given count of in-flight slots.
+ *
+ * @param limit The max. count of requests in flight at once (capped to MODBUS_INFLIGHT_LIMIT).
+ */
+ModbusScheduler::ModbusScheduler(uint8_t limit)
+{
+    this->limit = min(limit, static_cast<uint8_t>(MODBUS_INFLIGHT_LIMIT));
+}
+
+/**
+ * @brief Marks a register of a device to be read with the next flush.
+ *
+ * @param device The index of the device (see METER_DEVICES).
+ * @param address The start address of the register.
+ *
+ * @return true if the register is wanted now, false if the wanted list of the device is full.
+ */
+bool ModbusScheduler::want(uint8_t device, uint16_t address)
+{
+    uint8_t count = 0;
+
+    for (uint8_t i = 0; i < wantedCount; i++)
+    {
+        if (wanted[i].device != device)
+            continue;
+
+        // Skip if already wanted.
+        if (wanted[i].address == address)
+            return true;
+
+        count++;
+    }
+
+    if (device >= METER_DEVICE_COUNT || count >= REGISTER_COUNT || wantedCount >= SCHEDULER_SLOTS)
+        return false;
+
+    wanted[wantedCount++] = {device, address};
+
+    return true;
+}
+
+/**
+ * @brief Plans the next block requests for all wanted registers.
+ *
+ * Registers which are already part of an in-flight request are dropped, because the
+ * pending response will deliver them anyway. Only as many blocks as free in-flight
+ * slots are returned, all other registers stay wanted. The devices are served
+ * round-robin.
+ *
+ * @param blocks The output buffer for the blocks to send.
+ * @param maxBlocks The size of the output buffer.
+ *
+ * @return The count of blocks to send.
+ */
+uint8_t ModbusScheduler::next(ReadPlanner::Block* blocks, uint8_t maxBlocks)
+{
+    // Want timed out Blocks again.
+    requeue();
+
+    if (wantedCount == 0)
+        return 0;
+
+    // Drop lost Requests.
+    expire();
+
+    // Drop Registers which are already in Flight.
+    uint8_t kept = 0;
+
+    for (uint8_t i = 0; i < wantedCount; i++)
+    {
+        if (!isInFlight(wanted[i].device, wanted[i].address))
+            wanted[kept++] = wanted[i];
+    }
+
+    wantedCount = kept;
+
+    uint8_t free = limit - min(getInFlight(), limit);
+    uint8_t budget = min(free, maxBlocks);
+
+    if (wantedCount == 0 || budget == 0)
+    {
+        if (wantedCount > 0)
+            deferred++;
+
+        return 0;
+    }
+
+    uint8_t send = 0;
+    uint8_t served = cursor;
+
+    // Plan Blocks per Device (Round-Robin).
+    for (uint8_t d = 0; d < METER_DEVICE_COUNT && send < budget; d++)
+    {
+        uint8_t device = (cursor + d) % METER_DEVICE_COUNT;
+        uint16_t registers[REGISTER_COUNT];
+        uint8_t count = 0;
+
+        for (uint8_t i = 0; i < wantedCount; i++)
+        {
+            if (wanted[i].device == device)
+                registers[count++] = wanted[i].address;
+        }
+
+        if (count == 0)
+            continue;
+
+        // Merge wanted Registers into Blocks.
+        ReadPlanner::Block planned[REGISTER_COUNT];
+        uint8_t plannedCount = ReadPlanner::plan(registers, count, MODBUS_BLOCK_GAP, planned, REGISTER_COUNT,
+                                                 METER_DEVICES[device].map);
+
+        // Apply Backpressure.
+        for (uint8_t i = 0; i < plannedCount && send < budget; i++)
+        {
+            planned[i].device = device;
+            blocks[send++] = planned[i];
+        }
+
+        served = device;
+    }
+
+    // Continue with the next Device on the next Flush.
+    cursor = (served + 1) % METER_DEVICE_COUNT;
+
+    // Keep Registers of Blocks which are not sent.
+    kept = 0;
+
+    for (uint8_t i = 0; i < wantedCount; i++)
+    {
+        bool covered = false;
+
+        for (uint8_t j = 0; j < send && !covered; j++)
+        {
+            covered = blocks[j].device == wanted[i].device && ReadPlanner::contains(blocks[j], wanted[i].address);
+        }
+
+        if (!covered)
+            wanted[kept++] = wanted[i];
+    }
+
+    wantedCount = kept;
+
+    if (wantedCount > 0)
+        deferred++;
+
+    return send;
+}
+
+/**
+ * @brief Registers a block request as in flight.
+ *
+ * Must be called before the request is handed to the client, so a fast response
+ * always finds its entry. A request sent while no other request is in flight goes to
+ * the wire at once, its round-trip time contains no time queued behind other requests.
+ *
+ * @param token The token of the block request.
+ *
+ * @return true if a slot was free, false otherwise.
+ */
+bool ModbusScheduler::sent(uint32_t token)
+{
+    bool added = false;
+
+    portENTER_CRITICAL(&mux);
+
+    if (inFlightCount < MODBUS_INFLIGHT_LIMIT)
+    {
+        inFlight[inFlightCount] = {token, millis(), inFlightCount == 0};
+        inFlightCount++;
+        added = true;
+    }
+
+    portEXIT_CRITICAL(&mux);
+
+    return added;
+}
+
+/**
+ * @brief Releases the in-flight slot of a block request.
+ *
+ * Called from the data and error handlers of the Modbus client task.
+ *
+ * @param token The token of the finished block request.
+ * @param idle Receives if the request was sent while no other request was in flight (optional).
+ *
+ * @return The time in ms the request was in flight, or -1 if the token is unknown.
+ */
+long ModbusScheduler::complete(uint32_t token, bool* idle)
+{
+    long elapsed = -1;
+    bool alone = false;
+
+    portENTER_CRITICAL(&mux);
+
+    for (uint8_t i = 0; i < inFlightCount; i++)
+    {
+        if (inFlight[i].token == token)
+        {
+            elapsed = millis() - inFlight[i].sentAt;
+            alone = inFlight[i].idle;
+            inFlight[i] = inFlight[--inFlightCount];
+
+            break;
+        }
+    }
+
+    portEXIT_CRITICAL(&mux);
+
+    if (idle != nullptr)
+        *idle = alone;
+
+    return elapsed;
+}
+
+/**
+ * @brief Releases all in-flight slots and starts a new generation, e.g. after the
+ * connection was closed.
+ *
+ * Late responses of the released requests carry the old generation and are rejected
+ * by isCurrent().
+ *
+ * @return The count of released requests.
+ */
+uint8_t ModbusScheduler::clear()
+{
+    portENTER_CRITICAL(&mux);
+    uint8_t count = inFlightCount;
+    inFlightCount = 0;
+    generation = (generation + 1) % TOKEN_GENERATIONS;
+    portEXIT_CRITICAL(&mux);
+
+    return count;
+}
+
+/**
+ * @brief Tags a token with the current generation before it is handed to the client.
+ *
+ * @param token The token of the block request (see ReadPlanner::toToken).
+ *
+ * @return The tagged token.
+ */
+uint32_t ModbusScheduler::tag(uint32_t token) const
+{
+    return untag(token) | (static_cast<uint32_t>(generation) << TOKEN_GENERATION_SHIFT);
+}
+
+/**
+ * @brief Checks if a tagged token was sent since the last clear().
+ *
+ * @param token The tagged token of a response or error.
+ *
+ * @return true if the token belongs to the current generation.
+ */
+bool ModbusScheduler::isCurrent(uint32_t token) const
+{
+    return ((token & TOKEN_GENERATION) >> TOKEN_GENERATION_SHIFT) == generation;
+}
+
+/**
+ * @brief Removes the generation from a tagged token.
+ *
+ * @param token The tagged token.
+ *
+ * @return The token of the block request.
+ */
+uint32_t ModbusScheduler::untag(uint32_t token)
+{
+    return token & ~TOKEN_GENERATION;
+}
+
+/**
+ * @brief Marks a timed out block request to be sent again with the next flush.
+ *
+ * Called from the error handler of the Modbus client task. Every block is retried
+ * MODBUS_RETRIES times in a row, afterward it is given up until it is wanted again
+ * by the poll policy.
+ *
+ * @param token The token of the timed out block request.
+ *
+ * @return true if the block is retried, false if all retries are used up.
+ */
+bool ModbusScheduler::retry(uint32_t token)
+{
+    bool retried = false;
+
+    portENTER_CRITICAL(&mux);
+
+    uint8_t index = 0;
+
+    while (index < retryCount && retries[index].token != token)
+        index++;
+
+    if (index == retryCount && retryCount < SCHEDULER_SLOTS)
+        retries[retryCount++] = {token, 0, false};
+
+    if (index < retryCount)
+    {
+        if (retries[index].attempts < MODBUS_RETRIES)
+        {
+            retries[index].attempts++;
+            retries[index].pending = true;
+            retried = true;
+        }
+        else
+        {
+            // Give up and start counting again with the next Timeout.
+            retries[index] = retries[--retryCount];
+        }
+    }
+
+    portEXIT_CRITICAL(&mux);
+
+    return retried;
+}
+
+/**
+ * @brief Resets the retry state of a block request after a valid response.
+ *
+ * @param token The token of the answered block request.
+ */
+void ModbusScheduler::confirm(uint32_t token)
+{
+    portENTER_CRITICAL(&mux);
+
+    for (uint8_t i = 0; i < retryCount; i++)
+    {
+        if (retries[i].token == token)
+        {
+            retries[i] = retries[--retryCount];
+
+            break;
+        }
+    }
+
+    portEXIT_CRITICAL(&mux);
+}
+
+/**
+ * @brief Retrieves the count of requests which are currently in flight.
+ *
+ * @return The real queue depth of the client.
+ */
+uint8_t ModbusScheduler::getInFlight()
+{
+    portENTER_CRITICAL(&mux);
+    uint8_t count = inFlightCount;
+    portEXIT_CRITICAL(&mux);
+
+    return count;
+}
+
+/**
+ * @brief Retrieves the count of registers waiting for a free slot.
+ *
+ * @return The count of wanted registers.
+ */
+uint8_t ModbusScheduler::getWanted()
+{
+    return wantedCount;
+}
+
+/**
+ * @brief Retrieves how often a flush was delayed by backpressure.
+ *
+ * @return The count of deferred flushes.
+ */
+uint32_t ModbusScheduler::getDeferred()
+{
+    return deferred;
+}
+
+/**
+ * @brief Checks if a register of a device is covered by any in-flight request.
+ *
+ * @param device The index of the device.
+ * @param address The start address of the register.
+ *
+ * @return true if the register is already requested.
+ */
+bool ModbusScheduler::isInFlight(uint8_t device, uint16_t address)
+{
+    bool found = false;
+
+    portENTER_CRITICAL(&mux);
+
+    for (uint8_t i = 0; i < inFlightCount && !found; i++)
+    {
+        ReadPlanner::Block block = ReadPlanner::fromToken(inFlight[i].token);
+
+        found = block.device == device && ReadPlanner::contains(block, address);
+    }
+
+    portEXIT_CRITICAL(&mux);
+
+    return found;
+}
+
+/**
+ * @brief Drops in-flight entries which never received a data or error callback.
+ *
+ * The client reports every timeout through the error handler, so this is only a
+ * safety net to never lock up a slot forever.
+ */
+void ModbusScheduler::expire()
+{
+    unsigned long now = millis();
+
+    portENTER_CRITICAL(&mux);
+
+    for (uint8_t i = 0; i < inFlightCount;)
+    {
+        if (now - inFlight[i].sentAt > 2UL * MODBUS_TIMEOUT)
+            inFlight[i] = inFlight[--inFlightCount];
+        else
+            i++;
+    }
+
+    portEXIT_CRITICAL(&mux);
+}
+
+/**
+ * @brief Marks the registers of all pending retries as wanted.
+ */
+void ModbusScheduler::requeue()
+{
+    uint32_t tokens[SCHEDULER_SLOTS];
+    uint8_t count = 0;
+
+    portENTER_CRITICAL(&mux);
+
+    for (uint8_t i = 0; i < retryCount; i++)
+    {
+        if (retries[i].pending)
+        {
+            tokens[count++] = retries[i].token;
+            retries[i].pending = false;
+        }
+    }
+
+    portEXIT_CRITICAL(&mux);
+
+    for (uint8_t i = 0; i < count; i++)
+    {
+        ReadPlanner::Block block = ReadPlanner::fromToken(tokens[i]);
+
+        if (block.device >= METER_DEVICE_COUNT)
+            continue;
+
+        const RegisterMap& map = METER_DEVICES[block.device].map;
+
+        for (uint8_t j = 0; j < map.count; j++)
+        {
+            if (ReadPlanner::contains(block, map.registers[j].address))
+                want(block.device, map.registers[j].address);
+        }
+    }
+}
@@ -0,0 +1,111 @@
+//
+// Created by JanHe on 16.10.2026.
+//
+
+#ifndef MODBUSSCHEDULER_H
+#define MODBUSSCHEDULER_H
+
+#include <Arduino.h>
+
+#include "MeterRegisters.h"
+#include "PinOut.h"
+#include "ReadPlanner.h"
+
+// Max. wanted Registers and Retries of all Devices.
+#define SCHEDULER_SLOTS (REGISTER_COUNT * METER_DEVICE_COUNT)
+
+static_assert(SCHEDULER_SLOTS <= UINT8_MAX, "Too many METER_DEVICES for the Scheduler");
+
+/**
+ * @class ModbusScheduler
+ * @brief Keeps track of wanted and in-flight register reads of a single Modbus client.
+ *
+ * Registers are first marked as wanted. On every flush the scheduler drops wanted
+ * registers which are already covered by an in-flight request, plans the remaining
+ * registers into block requests and hands out only as many blocks as in-flight slots
+ * are free. Registers which do not fit are kept for the next flush (backpressure)
+ * instead of purging the client queue. Timed out blocks are marked as wanted again
+ * up to MODBUS_RETRIES times.
+ *
+ * Registers are wanted per device. Blocks are planned per device, and the free slots are
+ * handed out round-robin, starting with the device after the one served last, so no
+ * device on the bus can starve the others.
+ *
+ * Every clear() starts a new generation, which is tagged into the tokens sent afterward
+ * (see tag()). Late responses of requests sent before the clear are recognised by
+ * isCurrent() and must be dropped, otherwise they would complete a request of the same
+ * block sent again on the new connection. A generation is only reused after
+ * TOKEN_GENERATIONS clears, much longer than a request may stay in flight.
+ *
+ * The in-flight table is shared between the loop and the Modbus client task and is
+ * therefore guarded by a critical section.
+ */
+class ModbusScheduler
+{
+public:
+    explicit ModbusScheduler(uint8_t limit);
+    bool want(uint8_t device, uint16_t address);
+    uint8_t next(ReadPlanner::Block* blocks, uint8_t maxBlocks);
+    bool sent(uint32_t token);
+    long complete(uint32_t token, bool* idle = nullptr);
+    uint8_t clear();
+    uint32_t tag(uint32_t token) const;
+    bool isCurrent(uint32_t token) const;
+    static uint32_t untag(uint32_t token);
+    bool retry(uint32_t token);
+    void confirm(uint32_t token);
+    uint8_t getInFlight();
+    uint8_t getWanted();
+    uint32_t getDeferred();
+
+private:
+    /**
+     * @struct Request
+     * @brief A single in-flight block request.
+     */
+    struct Request
+    {
+        uint32_t token;
+        unsigned long sentAt;
+        bool idle;
+    };
+
+    /**
+     * @struct Wanted
+     * @brief A register of a device which should be read with the next flush.
+     */
+    struct Wanted
+    {
+        uint8_t device;
+        uint16_t address;
+    };
+
+    /**
+     * @struct Retry
+     * @brief The retry state of a timed out block request.
+     */
+    struct Retry
+    {
+        uint32_t token;
+        uint8_t attempts;
+        bool pending;
+    };
+
+    bool isInFlight(uint8_t device, uint16_t address);
+    void expire();
+    void requeue();
+    uint8_t limit;
+    Request inFlight[MODBUS_INFLIGHT_LIMIT];
+    uint8_t inFlightCount = 0;
+    Wanted wanted[SCHEDULER_SLOTS];
+    uint8_t wantedCount = 0;
+    uint8_t cursor = 0;
+    uint32_t deferred = 0;
+    Retry retries[SCHEDULER_SLOTS];
+    uint8_t retryCount = 0;
+    volatile uint8_t generation = 0;
+    portMUX_TYPE mux = portMUX_INITIALIZER_UNLOCKED;
+};
+
+
+#endif //MODBUSSCHEDULER_H
@@ -0,0 +1,254 @@
+//
+// Created by JanHe on 16.10.2026.
+//
+
+#include "ModbusStats.h"
+
+/**
+ * @brief Accounts a new request which was handed to the client.
+ */
+void ModbusStats::request()
+{
+    portENTER_CRITICAL(&mux);
+    summary.requests++;
+    windowRequests++;
+    portEXIT_CRITICAL(&mux);
+}
+
+/**
+ * @brief Records a successful response and its round-trip time.
+ *
+ * @param token The token of the answered request.
+ * @param rtt The round-trip time in ms (negative if unknown).
+ */
+void ModbusStats::response(uint32_t token, long rtt)
+{
+    portENTER_CRITICAL(&mux);
+
+    summary.responses++;
+
+    if (rtt >= 0)
+    {
+        // Find logarithmic Bucket (2^i ms).
+        uint8_t bucket = 0;
+
+        while (bucket < STATS_BUCKETS - 1 && (1UL << bucket) < static_cast<unsigned long>(rtt))
+            bucket++;
+
+        buckets[bucket]++;
+        samples++;
+    }
+
+    TokenStats* stats = findToken(token);
+
+    if (stats != nullptr)
+    {
+        stats->responses++;
+        stats->lastRtt = max(rtt, 0L);
+    }
+
+    portEXIT_CRITICAL(&mux);
+}
+
+/**
+ * @brief Records a failed request.
+ *
+ * @param token The token of the failed request.
+ * @param error The error reported by the client.
+ */
+void ModbusStats::error(uint32_t token, Error error)
+{
+    portENTER_CRITICAL(&mux);
+
+    switch (error)
+    {
+    case TIMEOUT:
+        summary.timeouts++;
+        break;
+    case CRC_ERROR:
+        summary.crcErrors++;
+        break;
+    default:
+        // Modbus Exceptions are sent by the Server, all Codes >= 0xE0 are Client Errors.
+        if (error < 0xE0)
+            summary.exceptions++;
+        else
+            summary.otherErrors++;
+        break;
+    }
+
+    TokenStats* stats = findToken(token);
+
+    if (stats != nullptr)
+        stats->errors++;
+
+    portEXIT_CRITICAL(&mux);
+}
+
+/**
+ * @brief Accounts a timed out block request which is sent again.
+ */
+void ModbusStats::retry()
+{
+    portENTER_CRITICAL(&mux);
+    summary.retries++;
+    portEXIT_CRITICAL(&mux);
+}
+
+/**
+ * @brief Records the duration of a transaction which was sent to an idle client.
+ *
+ * Unlike the RTT these transactions did not wait behind other requests, so the duration
+ * only contains the frame times, the turnaround of the bus and the reply delay of the
+ * device.
+ *
+ * @param duration The duration from the request to the response in µs.
+ */
+void ModbusStats::wire(uint32_t duration)
+{
+    portENTER_CRITICAL(&mux);
+
+    wireSum += duration;
+    summary.wireCount++;
+    summary.wireMin = (summary.wireCount == 1 ? duration : min(summary.wireMin, duration));
+    summary.wireMax = max(summary.wireMax, duration);
+    summary.wireMean = static_cast<uint32_t>(wireSum / summary.wireCount);
+
+    portEXIT_CRITICAL(&mux);
+}
+
+/**
+ * @brief Stores the current RTT estimation of the client.
+ *
+ * @param srtt The smoothed round-trip time in ms.
+ * @param timeout The adaptive request timeout in ms.
+ */
+void ModbusStats::timing(uint32_t srtt, uint32_t timeout)
+{
+    portENTER_CRITICAL(&mux);
+    summary.srtt = srtt;
+    summary.timeout = timeout;
+    portEXIT_CRITICAL(&mux);
+}
+
+/**
+ * @brief Updates the request rate and percentiles, should be called from the loop.
+ *
+ * The rate is calculated over a window of 10 seconds. Afterward the histogram is
+ * halved, so the percentiles follow the recent behaviour of the bus.
+ */
+void ModbusStats::update()
+{
+    unsigned long now = millis();
+
+    if (now - windowStart < 10000)
+        return;
+
+    portENTER_CRITICAL(&mux);
+
+    summary.rate = windowRequests * 1000.0F / (now - windowStart);
+    summary.p50 = percentile(50);
+    summary.p95 = percentile(95);
+    summary.p99 = percentile(99);
+    windowRequests = 0;
+
+    // Age Histogram.
+    samples = 0;
+
+    for (uint8_t i = 0; i < STATS_BUCKETS; i++)
+    {
+        buckets[i] /= 2;
+        samples += buckets[i];
+    }
+
+    portEXIT_CRITICAL(&mux);
+
+    windowStart = now;
+}
+
+/**
+ * @brief Retrieves a snapshot of the statistics.
+ *
+ * @return The summary of all counters, the request rate and RTT percentiles in ms.
+ */
+ModbusStats::Summary ModbusStats::getSummary()
+{
+    portENTER_CRITICAL(&mux);
+    Summary copy = summary;
+    portEXIT_CRITICAL(&mux);
+
+    return copy;
+}
+
+/**
+ * @brief Copies the per-token counters.
+ *
+ * @param tokens The output buffer.
+ * @param maxTokens The size of the output buffer.
+ *
+ * @return The count of copied entries.
+ */
+uint8_t ModbusStats::getTokens(TokenStats* tokens, uint8_t maxTokens)
+{
+    portENTER_CRITICAL(&mux);
+
+    uint8_t count = min(tokenCount, maxTokens);
+
+    for (uint8_t i = 0; i < count; i++)
+    {
+        tokens[i] = this->tokens[i];
+    }
+
+    portEXIT_CRITICAL(&mux);
+
+    return count;
+}
+
+/**
+ * @brief Finds or creates the counters of a token (must be called inside the critical section).
+ *
+ * @param token The request token.
+ *
+ * @return The counters or nullptr if the table is full.
+ */
+ModbusStats::TokenStats* ModbusStats::findToken(uint32_t token)
+{
+    for (uint8_t i = 0; i < tokenCount; i++)
+    {
+        if (tokens[i].token == token)
+            return &tokens[i];
+    }
+
+    if (tokenCount >= REGISTER_COUNT * METER_DEVICE_COUNT)
+        return nullptr;
+
+    tokens[tokenCount] = {token, 0, 0, 0};
+
+    return &tokens[tokenCount++];
+}
+
+/**
+ * @brief Estimates a percentile of the RTT histogram (must be called inside the critical section).
+ *
+ * @param percent The percentile (0 - 100).
+ *
+ * @return The upper bound of the bucket containing the percentile in ms.
+ */
+uint32_t ModbusStats::percentile(uint8_t percent)
+{
+    if (samples == 0)
+        return 0;
+
+    uint32_t target = (samples * percent + 99) / 100;
+    uint32_t sum = 0;
+
+    for (uint8_t i = 0; i < STATS_BUCKETS; i++)
+    {
+        sum += buckets[i];
+
+        if (sum >= target)
+            return 1UL << i;
+    }
+
+    return 1UL << (STATS_BUCKETS - 1);
+}
@@ -0,0 +1,95 @@
+//
+// Created by JanHe on 16.10.2026.
+//
+
+#ifndef MODBUSSTATS_H
+#define MODBUSSTATS_H
+
+#include <Arduino.h>
+
+#include "MeterRegisters.h"
+#include "ModbusMessage.h"
+
+// Count of RTT Histogram Buckets (Bucket i covers up to 2^i ms => max. 32 s).
+#define STATS_BUCKETS 16
+
+
+/**
+ * @class ModbusStats
+ * @brief Collects round-trip times and error counters of a single Modbus client.
+ *
+ * Round-trip times are sorted into a logarithmic histogram (powers of two in ms),
+ * from which the p50/p95/p99 values are estimated. Transactions sent to an idle client
+ * are additionally timed in µs (wire time without queueing, see wire()). Errors are
+ * split into timeouts, CRC errors and Modbus exceptions. Counters are additionally kept
+ * per request token.
+ *
+ * Samples are recorded from the Modbus client task and read from the loop, so all
+ * access is guarded by a critical section.
+ */
+class ModbusStats
+{
+public:
+    /**
+     * @struct Summary
+     * @brief Compact snapshot of the statistics for the display, HTTP and MQTT layers.
+     */
+    struct Summary
+    {
+        uint32_t requests;
+        uint32_t responses;
+        uint32_t timeouts;
+        uint32_t crcErrors;
+        uint32_t exceptions;
+        uint32_t otherErrors;
+        uint32_t retries;
+        float rate;
+        uint32_t p50;
+        uint32_t p95;
+        uint32_t p99;
+        uint32_t srtt;
+        uint32_t timeout;
+        uint32_t wireCount;
+        uint32_t wireMin;
+        uint32_t wireMean;
+        uint32_t wireMax;
+    };
+
+    /**
+     * @struct TokenStats
+     * @brief Counters of a single request token (block request).
+     */
+    struct TokenStats
+    {
+        uint32_t token;
+        uint32_t responses;
+        uint32_t errors;
+        uint32_t lastRtt;
+    };
+
+    void request();
+    void response(uint32_t token, long rtt);
+    void error(uint32_t token, Error error);
+    void retry();
+    void wire(uint32_t duration);
+    void timing(uint32_t srtt, uint32_t timeout);
+    void update();
+    Summary getSummary();
+    uint8_t getTokens(TokenStats* tokens, uint8_t maxTokens);
+
+private:
+    TokenStats* findToken(uint32_t token);
+    uint32_t percentile(uint8_t percent);
+    uint32_t buckets[STATS_BUCKETS] = {};
+    uint32_t samples = 0;
+    TokenStats tokens[REGISTER_COUNT * METER_DEVICE_COUNT] = {};
+    uint8_t tokenCount = 0;
+    Summary summary = {};
+    uint64_t wireSum = 0;
+    uint32_t windowRequests = 0;
+    unsigned long windowStart = 0;
+    portMUX_TYPE mux = portMUX_INITIALIZER_UNLOCKED;
+};
+
+
+#endif //MODBUSSTATS_H
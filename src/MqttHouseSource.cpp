@@ -0,0 +1,51 @@
+//
+// Created by JanHe on 16.10.2026.
+//
+
+#include "MqttHouseSource.h"
+
+/**
+ * @brief Constructs the MQTT source.
+ *
+ * @param topic The topic of the house power in W.
+ * @param key The JSON key of the value, or nullptr if the payload is a plain number.
+ */
+MqttHouseSource::MqttHouseSource(const char* topic, const char* key) : HouseSource("mqtt")
+{
+    this->topic = topic;
+    this->key = key;
+}
+
+/**
+ * @brief Nothing to poll, values are pushed by the broker.
+ */
+void MqttHouseSource::poll()
+{
+}
+
+/**
+ * @brief Parses a received message of the subscribed topic.
+ *
+ * Messages of other topics and payloads without a valid number (e.g. "unavailable")
+ * are ignored.
+ *
+ * @param topic The topic of the message.
+ * @param payload The payload (not zero terminated).
+ * @param length The length of the payload.
+ */
+void MqttHouseSource::handleMessage(const char* topic, const uint8_t* payload, uint16_t length)
+{
+    if (strcmp(topic, this->topic) != 0)
+        return;
+
+    char text[128];
+    size_t size = min(static_cast<size_t>(length), sizeof(text) - 1);
+
+    memcpy(text, payload, size);
+    text[size] = '\0';
+
+    float value;
+
+    if (parseValue(text, key, value))
+        update(value);
+}
@@ -0,0 +1,31 @@
+//
+// Created by JanHe on 16.10.2026.
+//
+
+#ifndef MQTTHOUSESOURCE_H
+#define MQTTHOUSESOURCE_H
+
+#include "HouseSource.h"
+
+
+/**
+ * @class MqttHouseSource
+ * @brief Receives the house power from a MQTT topic (e.g. the grid sensor of Home Assistant).
+ *
+ * The topic is subscribed on the broker of the Home Assistant integration (see
+ * HomeAssistant::subscribe). Nothing is polled, the publisher defines the interval.
+ */
+class MqttHouseSource : public HouseSource
+{
+public:
+    MqttHouseSource(const char* topic, const char* key);
+    void poll() override;
+    void handleMessage(const char* topic, const uint8_t* payload, uint16_t length);
+
+private:
+    const char* topic;
+    const char* key;
+};
+
+
+#endif //MQTTHOUSESOURCE_H
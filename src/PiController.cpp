@@ -0,0 +1,208 @@
+//
+// Created by JanHe on 16.10.2026.
+//
+
+#include "PiController.h"
+
+// Max. Time Step of the Integral in ms (e.g. after a Lock or a Gap of Samples).
+#define PI_MAX_STEP 2000
+
+/**
+ * @brief Constructs a PI controller.
+ *
+ * @param kp The proportional gain (output per error unit).
+ * @param ki The integral gain (output per error unit and second).
+ * @param deadband The error around zero which is treated as zero.
+ * @param minimum The lowest output.
+ * @param maximum The highest output.
+ */
+PiController::PiController(float kp, float ki, float deadband, float minimum, float maximum)
+{
+    this->kp = kp;
+    this->ki = ki;
+    this->deadband = deadband;
+    this->minimum = minimum;
+    this->maximum = maximum;
+}
+
+/**
+ * @brief Calculates the next output from the current error.
+ *
+ * The time step of the integral is measured since the last update, reset() or track().
+ *
+ * @param error The setpoint minus the measured value.
+ *
+ * @return The clamped output.
+ */
+float PiController::update(float error)
+{
+    unsigned long now = millis();
+    float dt = min(now - lastUpdate, static_cast<unsigned long>(PI_MAX_STEP)) / 1000.0F;
+
+    lastUpdate = now;
+
+    // Ignore small Errors around the Setpoint.
+    if (fabsf(error) <= deadband)
+        error = 0;
+
+    proportional = kp * error;
+
+    float candidate = integral + ki * error * dt;
+    float raw = proportional + candidate;
+
+    // Anti-Windup (integrate only if not saturated or unwinding).
+    if ((raw < maximum || error < 0) && (raw > minimum || error > 0))
+        integral = constrain(candidate, minimum, maximum);
+
+    output = constrain(proportional + integral, minimum, maximum);
+
+    return output;
+}
+
+/**
+ * @brief Takes over an output which was changed outside the controller.
+ *
+ * Differences below one output unit are rounding of the caller and are ignored.
+ *
+ * @param output The output which is actually applied.
+ */
+void PiController::track(float output)
+{
+    if (fabsf(output - this->output) < 1.0F)
+        return;
+
+    integral = constrain(output - proportional, minimum, maximum);
+    this->output = output;
+}
+
+/**
+ * @brief Restarts the controller at a fixed output.
+ *
+ * @param output The output to continue from.
+ */
+void PiController::reset(float output)
+{
+    proportional = 0;
+    integral = constrain(output, minimum, maximum);
+    this->output = integral;
+    lastUpdate = millis();
+}
+
+/**
+ * @brief Continues from the terms of another controller, e.g. from a state snapshot.
+ *
+ * @param proportional The proportional term.
+ * @param integral The integral term.
+ */
+void PiController::restore(float proportional, float integral)
+{
+    this->proportional = proportional;
+    this->integral = constrain(integral, minimum, maximum);
+    output = constrain(proportional + this->integral, minimum, maximum);
+    lastUpdate = millis();
+}
+
+/**
+ * @brief Sets the proportional gain.
+ *
+ * @param kp The gain (output per error unit).
+ */
+void PiController::setProportional(float kp)
+{
+    this->kp = kp;
+}
+
+/**
+ * @brief Sets the integral gain.
+ *
+ * @param ki The gain (output per error unit and second).
+ */
+void PiController::setIntegral(float ki)
+{
+    this->ki = ki;
+}
+
+/**
+ * @brief Sets the deadband around the setpoint.
+ *
+ * @param deadband The error which is treated as zero.
+ */
+void PiController::setDeadband(float deadband)
+{
+    this->deadband = deadband;
+}
+
+/**
+ * @brief Sets the output range and clamps the integral into it.
+ *
+ * @param minimum The lowest output.
+ * @param maximum The highest output.
+ */
+void PiController::setLimits(float minimum, float maximum)
+{
+    this->minimum = minimum;
+    this->maximum = maximum;
+
+    integral = constrain(integral, minimum, maximum);
+    output = constrain(output, minimum, maximum);
+}
+
+/**
+ * @brief Retrieves the proportional gain.
+ *
+ * @return The gain.
+ */
+float PiController::getProportional() const
+{
+    return kp;
+}
+
+/**
+ * @brief Retrieves the integral gain.
+ *
+ * @return The gain.
+ */
+float PiController::getIntegral() const
+{
+    return ki;
+}
+
+/**
+ * @brief Retrieves the deadband around the setpoint.
+ *
+ * @return The deadband.
+ */
+float PiController::getDeadband() const
+{
+    return deadband;
+}
+
+/**
+ * @brief Retrieves the last output.
+ *
+ * @return The clamped output.
+ */
+float PiController::getOutput() const
+{
+    return output;
+}
+
+/**
+ * @brief Retrieves the proportional term of the last output.
+ *
+ * @return The proportional term.
+ */
+float PiController::getProportionalTerm() const
+{
+    return proportional;
+}
+
+/**
+ * @brief Retrieves the integral term of the last output.
+ *
+ * @return The integral term.
+ */
+float PiController::getIntegralTerm() const
+{
+    return integral;
+}
@@ -0,0 +1,53 @@
+//
+// Created by JanHe on 16.10.2026.
+//
+
+#ifndef PICONTROLLER_H
+#define PICONTROLLER_H
+
+#include <Arduino.h>
+
+
+/**
+ * @class PiController
+ * @brief A PI controller with deadband, output clamping and anti-windup.
+ *
+ * Errors inside the deadband count as zero, so the output holds instead of hunting
+ * around the setpoint. The integral is only advanced while the output is not saturated
+ * (or the error drives it back out of saturation) and is clamped to the output range.
+ * If the output was changed by someone else (e.g. a power limit), track() takes it over
+ * as new integral, so the next step continues from there without a bump.
+ */
+class PiController
+{
+public:
+    PiController(float kp, float ki, float deadband, float minimum, float maximum);
+    float update(float error);
+    void track(float output);
+    void reset(float output);
+    void restore(float proportional, float integral);
+    void setProportional(float kp);
+    void setIntegral(float ki);
+    void setDeadband(float deadband);
+    void setLimits(float minimum, float maximum);
+    float getProportional() const;
+    float getIntegral() const;
+    float getDeadband() const;
+    float getOutput() const;
+    float getProportionalTerm() const;
+    float getIntegralTerm() const;
+
+private:
+    float kp;
+    float ki;
+    float deadband;
+    float minimum;
+    float maximum;
+    float integral = 0;
+    float proportional = 0;
+    float output = 0;
+    unsigned long lastUpdate = 0;
+};
+
+
+#endif //PICONTROLLER_H
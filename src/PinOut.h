@@ -25,10 +25,116 @@
 #define STANDBY_INTERVAL 30
 
 #define MODBUS_TIMEOUT 15000
+// Core of the Modbus Client Tasks.
 #define MODBUS_CORE 1
 #define MODBUS_BAUD 9600
 #define MODBUS_TCP {192, 168, 5, 24}
 #define MODBUS_TCP_PORT 502
+#define MODBUS_TCP_SERVER_ID 1
+// Max. Requests in flight on the Modbus TCP Socket (max. MODBUS_INFLIGHT_LIMIT, Power, Phases and Export => 2 Blocks).
+#define MODBUS_TCP_INFLIGHT 4
+// Close the Socket after ms without Requests (longer than MODBUS_TCP_PROBE keeps it open).
+#define MODBUS_TCP_IDLE 60000
+// Probe the House Meter after ms without Response, reconnect after MODBUS_TCP_DEAD ms or MODBUS_TCP_FAILURES Errors.
+#define MODBUS_TCP_PROBE 5000
+#define MODBUS_TCP_DEAD 15000
+#define MODBUS_TCP_FAILURES 3
+// Reconnect Backoff in ms (doubled after every failed Reconnect).
+#define MODBUS_TCP_BACKOFF_MIN 1000
+#define MODBUS_TCP_BACKOFF_MAX 60000
+
+// Max. unused Registers between two Registers within one Block Request.
+#define MODBUS_BLOCK_GAP 24
+// Max. Registers per Block Request (Eastron allows up to 80).
+#define MODBUS_BLOCK_MAX 40
+// Max. Block Requests in Flight per Client (Backpressure instead of purging the Queue).
+#define MODBUS_INFLIGHT_LIMIT 4
+
+// Adaptive Timeout (SRTT + 4 * RTTVAR) until the first Response, Floor and Ceiling in ms.
+#define MODBUS_TIMEOUT_INITIAL 1000
+#define MODBUS_TIMEOUT_MIN 250
+#define MODBUS_TIMEOUT_MAX MODBUS_TIMEOUT
+// Max. Retries of a timed out Block Request before waiting for the next Poll.
+#define MODBUS_RETRIES 2
+
+// Highest Baud Rate Index to negotiate with the Meter (0=2400, 1=4800, 2=9600, 3=19200, 4=38400).
+#define MODBUS_BAUD_MAX 4
+// Successful Reads before a negotiated Baud Rate is accepted and stored.
+#define MODBUS_BAUD_VERIFY 5
+// CRC Errors per Minute before falling back to the next lower Baud Rate.
+#define MODBUS_BAUD_CRC_LIMIT 5
+
+// Max. Age of Meter Samples in ms before the Controller treats them as stale.
+#define STALE_POWER 5000
+#define STALE_HOUSE 5000
+#define STALE_CONSUMPTION 180000
+// Controller Action on stale Samples (STALE_HOLD, STALE_RAMP_DOWN, STALE_STANDBY).
+#define STALE_ACTION STALE_RAMP_DOWN
+
+// 1 = Run a Control Step on every fresh House Power Sample (DYNAMIC Mode with CONTROL_PI), 0 = fixed Tick only.
+#define CONTROL_EVENT 1
+// Min. Time between two Control Steps in ms.
+#define CONTROL_MIN_INTERVAL 100
+// Max. Time between two Control Steps in ms (Watchdog Tick without fresh Samples).
+#define CONTROL_WATCHDOG 500
+// 1 = Run Polling and Control Steps in an own FreeRTOS Task, 0 = inside the Arduino Loop.
+#define CONTROL_TASK 1
+// Period in ms, Core, Priority and Stack Size of the Control Task (the Arduino Loop runs on Core 1 with Priority 1).
+#define CONTROL_TASK_PERIOD 50
+#define CONTROL_TASK_CORE 1
+#define CONTROL_TASK_PRIORITY 5
+#define CONTROL_TASK_STACK 6144
+// 1 = PI Controller for DYNAMIC Mode, 0 = fixed Steps of SCR_PWM_STEP.
+#define CONTROL_PI 1
+// Grid Power Setpoint in W (negative = keep a small Export).
+#define CONTROL_SETPOINT 0.0F
+// Default Gains (Duty per W / Duty per W and Second) and Deadband in W around the Setpoint.
+#define CONTROL_KP 0.05F
+#define CONTROL_KI 0.1F
+#define CONTROL_DEADBAND 25.0F
+// 1 = Dither the fractional PI Output across Control Ticks (Sigma-Delta), 0 = round to whole Duty Counts.
+#define CONTROL_DITHER 0
+// 1 = Feed-Forward of the Heater Power needed to balance the House Power (PI only trims the Residual).
+#define CONTROL_FF 1
+// Min. Error in W which is balanced by the Feed-Forward instead of the PI Controller.
+#define CONTROL_FF_BAND 300.0F
+// Initial Slope of the Heater in W per Duty Count (until the Power Curve is learned from the local Meter).
+#define CONTROL_FF_SLOPE 6.0F
+// Lowest Duty used to learn the Power Curve (below the SCR barely fires).
+#define CONTROL_FF_MIN_DUTY 20
+// Interval in ms to store the learned Power Curve in the NVS (only if it changed).
+#define CONTROL_FF_SAVE 600000
+// Time in ms after an Output Change until Meter Samples reflect it.
+#define CONTROL_FF_SETTLE 1000
+
+// 1 = Print Meter, Sensor, Button and HA Inputs and the Output Decisions as Capture Lines for the Replay.
+#define CAPTURE 0
+// Interval in ms of the State Snapshot (Mode, Limits, Gains, Duty) in the Capture.
+#define CAPTURE_STATE 60000
+
+// Modbus TCP Server mirroring the cached local Meter Registers (Server IDs of METER_DEVICES).
+#define MIRROR_PORT 502
+#define MIRROR_CLIENTS 4
+#define MIRROR_TIMEOUT 20000
+// Age (float32 Seconds) of Register X is served at X + MIRROR_AGE_OFFSET.
+#define MIRROR_AGE_OFFSET 0x1000
+
+// House Power Sources (1 = enabled), the healthy Source with the shortest Interval is used, the Order only decides
+// between equal Intervals.
+#define HOUSE_MODBUS 1
+#define HOUSE_MQTT 0
+#define HOUSE_HTTP 0
+// MQTT Topic of the House Power in W (plain Number, or JSON with HOUSE_MQTT_KEY).
+#define HOUSE_MQTT_TOPIC "homeassistant/sensor/grid_power/state"
+#define HOUSE_MQTT_KEY nullptr
+// HTTP JSON Endpoint of a local Energy Meter (e.g. Shelly Pro 3EM).
+#define HOUSE_HTTP_HOST "192.168.1.50"
+#define HOUSE_HTTP_PORT 80
+#define HOUSE_HTTP_PATH "/rpc/EM.GetStatus?id=0"
+#define HOUSE_HTTP_KEY "total_act_power"
+#define HOUSE_HTTP_INTERVAL 1000
+// A faster Source is only picked if its Interval is below this Ratio of the active one.
+#define HOUSE_SWITCH_RATIO 0.75F
 
 // Server ID / Input Type / CRC Size / High / Low
 #define MODBUS_OFFSET 3
@@ -43,6 +149,10 @@
 #define MODBUS_TX 17
 #define MODBUS_RX 16
 #define MODBUS_RE 4
+// 1 = UART drives DE/RE via RTS (RS485 Half Duplex Mode), 0 = GPIO toggled by the RTU Client.
+#define MODBUS_RS485_HARDWARE 0
+// 1 = Listen only on the RTU Bus and decode the Requests of another Master (nothing is sent).
+#define MODBUS_SNIFFER 0
 
 #define ONE_WIRE 22
 
@@ -65,6 +175,22 @@
 #define SCR_PWM_RANGE 900
 #define SCR_PWM_STEP 10
 
+// Heater Channels (see HeaterChannels.h), max. Power per Phase in W of all Channels (0 = unlimited).
+#define HEATER_PHASE_LIMIT 0.0F
+// Duty of a staged Channel to switch its Relay on / off (the first Channel follows the SCR State).
+#define HEATER_STAGE_ON 50
+#define HEATER_STAGE_OFF 10
+// Min. Time in ms between two Relay Switches of a staged Channel.
+#define HEATER_STAGE_HOLD 30000
+// 1 = Burst-Fire: PWM at full Range, whole Mains Cycles fired by the Enable Pin (needs zero-cross SCRs).
+#define BURST_FIRE 0
+// Length of a Mains Cycle in µs (50 Hz).
+#define BURST_CYCLE 20000
+// Count of Mains Cycles per Packet.
+#define BURST_PACKET 50
+// Distribution of the on Cycles in a Packet: 0 = spread evenly, 1 = one Block.
+#define BURST_PATTERN 0
+
 // Display and I2C Stuff.
 #define DISPLAY_I2C_SDA 32
 #define DISPLAY_I2C_SCL 33
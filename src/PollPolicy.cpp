@@ -0,0 +1,72 @@
+//
+// Created by JanHe on 16.10.2026.
+//
+
+#include "PollPolicy.h"
+
+/**
+ * @brief Constructs a polling policy.
+ *
+ * @param minInterval The shortest polling interval in ms (used during fast changes).
+ * @param maxInterval The longest polling interval in ms (used while the value is calm).
+ * @param threshold The change between two reads which counts as fast change.
+ */
+PollPolicy::PollPolicy(unsigned long minInterval, unsigned long maxInterval, float threshold)
+{
+    this->minInterval = minInterval;
+    this->maxInterval = maxInterval;
+    this->interval = maxInterval;
+    this->threshold = threshold;
+}
+
+/**
+ * @brief Checks whether the register should be polled now.
+ *
+ * If the interval elapsed, the poll is accounted and true is returned, so the caller
+ * is expected to request the register afterward.
+ *
+ * @return true if the register is due for polling.
+ */
+bool PollPolicy::isDue()
+{
+    unsigned long now = millis();
+
+    if (now - lastPoll < interval)
+        return false;
+
+    lastPoll = now;
+
+    return true;
+}
+
+/**
+ * @brief Adapts the interval to a new value of the register.
+ *
+ * @param value The new value read from the register.
+ */
+void PollPolicy::update(float value)
+{
+    if (std::isfinite(lastValue))
+    {
+        float delta = fabsf(value - lastValue);
+
+        // Tighten on fast Changes.
+        if (delta > threshold)
+            interval = max(minInterval, interval / 2);
+        // Relax while the Value is calm.
+        else if (delta < threshold / 4)
+            interval = min(maxInterval, interval + interval / 4);
+    }
+
+    lastValue = value;
+}
+
+/**
+ * @brief Retrieves the current polling interval.
+ *
+ * @return The current interval in ms.
+ */
+unsigned long PollPolicy::getInterval() const
+{
+    return interval;
+}
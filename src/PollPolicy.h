@@ -0,0 +1,38 @@
+//
+// Created by JanHe on 16.10.2026.
+//
+
+#ifndef POLLPOLICY_H
+#define POLLPOLICY_H
+
+#include <Arduino.h>
+
+
+/**
+ * @class PollPolicy
+ * @brief Adapts the polling interval of a single register to how fast its value changes.
+ *
+ * The interval starts at the max. interval. Every time the value changes by more than
+ * the threshold between two reads, the interval is halved (down to the min. interval).
+ * While the value stays calm, the interval relaxes again by 25% per read (up to the
+ * max. interval).
+ */
+class PollPolicy
+{
+public:
+    PollPolicy(unsigned long minInterval, unsigned long maxInterval, float threshold);
+    bool isDue();
+    void update(float value);
+    unsigned long getInterval() const;
+
+private:
+    unsigned long minInterval;
+    unsigned long maxInterval;
+    unsigned long interval;
+    unsigned long lastPoll = 0;
+    float threshold;
+    float lastValue = NAN;
+};
+
+
+#endif //POLLPOLICY_H
@@ -0,0 +1,212 @@
+//
+// Created by JanHe on 16.10.2026.
+//
+
+#include "PowerAllocator.h"
+
+#include <utility>
+
+#include "PinOut.h"
+
+// Count of Phases.
+#define ALLOCATOR_PHASES 3
+
+
+/**
+ * @brief Constructs the allocator and sorts the channels by priority.
+ *
+ * @param configs The channel configurations (see HEATER_CHANNELS).
+ * @param count The count of channels.
+ * @param phaseLimit The max. power per phase in W (0 = unlimited).
+ */
+PowerAllocator::PowerAllocator(const ChannelConfig* configs, uint8_t count, float phaseLimit)
+{
+    this->count = min(count, static_cast<uint8_t>(ALLOCATOR_CHANNELS));
+    this->phaseLimit = phaseLimit;
+
+    for (uint8_t i = 0; i < this->count; i++)
+    {
+        channels[i] = new HeaterChannel(configs[i]);
+        order[i] = i;
+    }
+
+    // Sort by Priority (stable, equal Priorities keep the Configuration Order).
+    for (uint8_t i = 1; i < this->count; i++)
+    {
+        for (uint8_t j = i; j > 0 && configs[order[j]].priority < configs[order[j - 1]].priority; j--)
+        {
+            std::swap(order[j], order[j - 1]);
+        }
+    }
+}
+
+/**
+ * @brief Configures the pins of all channels and calculates the capacity.
+ */
+void PowerAllocator::begin()
+{
+    float phases[ALLOCATOR_PHASES] = {};
+
+    capacity = 0;
+
+    for (uint8_t i = 0; i < count; i++)
+    {
+        HeaterChannel& channel = *channels[order[i]];
+        uint32_t limit = limitOf(channel, phases);
+
+        channel.begin();
+
+        capacity += limit;
+        phases[(channel.getConfig().phase - 1) % ALLOCATOR_PHASES] += channel.getConfig().power * limit / SCR_PWM_RANGE;
+    }
+
+#if BURST_FIRE
+    if (timer == nullptr)
+    {
+        esp_timer_create_args_t args = {};
+        args.callback = &handleBurst;
+        args.arg = this;
+        args.name = "burst";
+
+        esp_timer_create(&args, &timer);
+        esp_timer_start_periodic(timer, BURST_CYCLE);
+    }
+#endif
+}
+
+/**
+ * @brief Distributes a total duty across the channels.
+ *
+ * @param total The total duty (0 to the capacity).
+ * @param enabled false to disable all SCRs.
+ */
+void PowerAllocator::allocate(uint32_t total, bool enabled)
+{
+    float phases[ALLOCATOR_PHASES] = {};
+    uint32_t remaining = total;
+
+    for (uint8_t i = 0; i < count; i++)
+    {
+        HeaterChannel& channel = *channels[order[i]];
+        uint32_t share = min(remaining, limitOf(channel, phases));
+
+        // The first Channel follows the SCR State, further Channels are staged.
+        bool on = (i == 0 ? enabled : isStaged(channel, share, enabled));
+
+        if (!on && i > 0)
+            share = 0;
+
+        channel.setDuty(share);
+        channel.setEnabled(on);
+
+        remaining -= share;
+        phases[(channel.getConfig().phase - 1) % ALLOCATOR_PHASES] += channel.getConfig().power * share / SCR_PWM_RANGE;
+    }
+}
+
+/**
+ * @brief Calculates the max. duty of a channel inside the headroom of its phase.
+ *
+ * @param channel The channel.
+ * @param phases The power already allocated per phase in W.
+ *
+ * @return The max. duty.
+ */
+uint32_t PowerAllocator::limitOf(const HeaterChannel& channel, const float* phases) const
+{
+    const ChannelConfig& config = channel.getConfig();
+
+    if (phaseLimit <= 0 || config.power <= 0)
+        return SCR_PWM_RANGE;
+
+    float headroom = max(0.0F, phaseLimit - phases[(config.phase - 1) % ALLOCATOR_PHASES]);
+
+    return min(static_cast<uint32_t>(headroom / config.power * SCR_PWM_RANGE), static_cast<uint32_t>(SCR_PWM_RANGE));
+}
+
+/**
+ * @brief Decides the relay state of a staged channel with hysteresis and hold time.
+ *
+ * @param channel The channel.
+ * @param share The duty the channel would get.
+ * @param enabled false if all SCRs are disabled.
+ *
+ * @return true if the relay should be on.
+ */
+bool PowerAllocator::isStaged(HeaterChannel& channel, uint32_t share, bool enabled) const
+{
+    if (!enabled)
+        return false;
+
+    bool held = (channel.getSwitched() != 0 && millis() - channel.getSwitched() < HEATER_STAGE_HOLD);
+
+    if (held)
+        return channel.isEnabled();
+
+    if (channel.isEnabled())
+        return share >= HEATER_STAGE_OFF;
+
+    return share >= HEATER_STAGE_ON;
+}
+
+/**
+ * @brief Fires the next mains cycle of every channel (timer task).
+ *
+ * @param arg The allocator.
+ */
+void PowerAllocator::handleBurst(void* arg)
+{
+    auto* allocator = static_cast<PowerAllocator*>(arg);
+
+    for (uint8_t i = 0; i < allocator->count; i++)
+        allocator->channels[i]->tick();
+}
+
+/**
+ * @brief Retrieves the max. total duty inside the phase limits.
+ *
+ * @return The capacity.
+ */
+uint32_t PowerAllocator::getCapacity() const
+{
+    return capacity;
+}
+
+/**
+ * @brief Retrieves the applied duty of all channels.
+ *
+ * Shares of unstaged channels are not applied, so the sum may be below the total.
+ *
+ * @return The duty.
+ */
+uint32_t PowerAllocator::getDuty() const
+{
+    uint32_t duty = 0;
+
+    for (uint8_t i = 0; i < count; i++)
+        duty += channels[i]->getDuty();
+
+    return duty;
+}
+
+/**
+ * @brief Retrieves the count of channels.
+ *
+ * @return The count.
+ */
+uint8_t PowerAllocator::getCount() const
+{
+    return count;
+}
+
+/**
+ * @brief Retrieves a channel in configuration order.
+ *
+ * @param index The index of the channel (see HEATER_CHANNELS).
+ *
+ * @return The channel.
+ */
+const HeaterChannel& PowerAllocator::getChannel(uint8_t index) const
+{
+    return *channels[index];
+}
@@ -0,0 +1,52 @@
+//
+// Created by JanHe on 16.10.2026.
+//
+
+#ifndef POWERALLOCATOR_H
+#define POWERALLOCATOR_H
+
+#include <Arduino.h>
+#include <esp_timer.h>
+
+#include "HeaterChannel.h"
+
+// Max. Count of Heater Channels.
+#define ALLOCATOR_CHANNELS 8
+
+
+/**
+ * @class PowerAllocator
+ * @brief Splits the total duty of the controller across the heater channels.
+ *
+ * The channels are filled in order of their priority, each up to SCR_PWM_RANGE or
+ * the headroom left on its phase (HEATER_PHASE_LIMIT). The first channel follows the
+ * SCR state and trims the power. Every further channel is staged: its relay switches on
+ * once its share reaches HEATER_STAGE_ON and off below HEATER_STAGE_OFF, never faster
+ * than HEATER_STAGE_HOLD. An unstaged channel gets no share, which passes to the next
+ * channel. With BURST_FIRE a periodic timer ticks every channel once per mains cycle.
+ */
+class PowerAllocator
+{
+public:
+    PowerAllocator(const ChannelConfig* configs, uint8_t count, float phaseLimit);
+    void begin();
+    void allocate(uint32_t total, bool enabled);
+    uint32_t getCapacity() const;
+    uint32_t getDuty() const;
+    uint8_t getCount() const;
+    const HeaterChannel& getChannel(uint8_t index) const;
+
+private:
+    uint32_t limitOf(const HeaterChannel& channel, const float* phases) const;
+    bool isStaged(HeaterChannel& channel, uint32_t share, bool enabled) const;
+    static void handleBurst(void* arg);
+    HeaterChannel* channels[ALLOCATOR_CHANNELS] = {};
+    uint8_t order[ALLOCATOR_CHANNELS] = {};
+    uint8_t count;
+    float phaseLimit;
+    uint32_t capacity = 0;
+    esp_timer_handle_t timer = nullptr;
+};
+
+
+#endif //POWERALLOCATOR_H
@@ -0,0 +1,236 @@
+//
+// Created by JanHe on 16.10.2026.
+//
+
+#include "PowerModel.h"
+
+#include <Preferences.h>
+
+// Store NVS Instance of the Power Curve.
+Preferences powerPreferences;
+
+
+/**
+ * @brief Constructs a power model.
+ *
+ * @param slope The initial slope in W per duty count (used until points were learned).
+ * @param minDuty The lowest duty which is used for learning.
+ * @param range The highest duty.
+ */
+PowerModel::PowerModel(float slope, uint32_t minDuty, uint32_t range)
+{
+    this->slope = slope;
+    this->minDuty = minDuty;
+    this->range = range;
+}
+
+/**
+ * @brief Loads the stored curve from the NVS.
+ *
+ * A stored curve of another size (other POWER_BINS) is ignored.
+ *
+ * @param name The NVS namespace of the curve.
+ */
+void PowerModel::begin(const char* name)
+{
+    this->name = name;
+
+    powerPreferences.begin(name, true);
+
+    if (powerPreferences.getBytesLength("curve") == sizeof(bins))
+        powerPreferences.getBytes("curve", bins, sizeof(bins));
+
+    powerPreferences.end();
+}
+
+/**
+ * @brief Learns from a measured power at a settled duty.
+ *
+ * The first pair of a bin replaces it, later pairs are smoothed.
+ *
+ * @param duty The duty which was applied while the power was measured.
+ * @param power The measured power of the heater in W.
+ */
+void PowerModel::learn(uint32_t duty, float power)
+{
+    if (duty < minDuty || duty > range || !std::isfinite(power) || power <= 0)
+        return;
+
+    Bin& bin = bins[duty * POWER_BINS / (range + 1)];
+
+    if (bin.samples == 0)
+    {
+        bin.duty = duty;
+        bin.power = power;
+    }
+    else
+    {
+        bin.duty = (7 * bin.duty + duty) / 8;
+        bin.power = (7 * bin.power + power) / 8;
+    }
+
+    if (bin.samples < UINT16_MAX)
+        bin.samples++;
+
+    samples++;
+    dirty = true;
+}
+
+/**
+ * @brief Stores the curve in the NVS (only if it changed since the last call).
+ */
+void PowerModel::save()
+{
+    if (!dirty || name == nullptr)
+        return;
+
+    powerPreferences.begin(name, false);
+    powerPreferences.putBytes("curve", bins, sizeof(bins));
+    powerPreferences.end();
+
+    dirty = false;
+}
+
+/**
+ * @brief Collects the learned points of the curve.
+ *
+ * The origin is the first point. The power is kept non-decreasing, so the curve can
+ * be inverted even if the meter noise breaks the order of two close bins.
+ *
+ * @param duties The duties of the points (POWER_BINS + 1 entries).
+ * @param powers The powers of the points (POWER_BINS + 1 entries).
+ *
+ * @return The count of points including the origin.
+ */
+uint8_t PowerModel::collect(float* duties, float* powers) const
+{
+    uint8_t count = 1;
+
+    duties[0] = 0;
+    powers[0] = 0;
+
+    for (uint8_t i = 0; i < POWER_BINS; i++)
+    {
+        if (bins[i].samples == 0 || bins[i].duty <= duties[count - 1])
+            continue;
+
+        duties[count] = bins[i].duty;
+        powers[count] = max(bins[i].power, powers[count - 1]);
+        count++;
+    }
+
+    return count;
+}
+
+/**
+ * @brief Calculates the duty which draws the given power.
+ *
+ * @param power The power in W.
+ *
+ * @return The duty (not clamped).
+ */
+float PowerModel::toDuty(float power) const
+{
+    float duties[POWER_BINS + 1];
+    float powers[POWER_BINS + 1];
+    uint8_t count = collect(duties, powers);
+
+    if (count == 1)
+        return power / slope;
+
+    for (uint8_t i = 1; i < count; i++)
+    {
+        if (power <= powers[i])
+        {
+            float span = powers[i] - powers[i - 1];
+
+            if (span <= 0)
+                return duties[i - 1];
+
+            return duties[i - 1] + (power - powers[i - 1]) * (duties[i] - duties[i - 1]) / span;
+        }
+    }
+
+    // Extrapolate proportional to the last Point.
+    return power * duties[count - 1] / powers[count - 1];
+}
+
+/**
+ * @brief Calculates the power drawn at the given duty.
+ *
+ * @param duty The duty.
+ *
+ * @return The power in W.
+ */
+float PowerModel::toPower(float duty) const
+{
+    float duties[POWER_BINS + 1];
+    float powers[POWER_BINS + 1];
+    uint8_t count = collect(duties, powers);
+
+    if (count == 1)
+        return duty * slope;
+
+    for (uint8_t i = 1; i < count; i++)
+    {
+        if (duty <= duties[i])
+            return powers[i - 1] + (duty - duties[i - 1]) * (powers[i] - powers[i - 1]) / (duties[i] - duties[i - 1]);
+    }
+
+    // Extrapolate proportional to the last Point.
+    return duty * powers[count - 1] / duties[count - 1];
+}
+
+/**
+ * @brief Checks if the curve covers the given power by learned points.
+ *
+ * @param power The power in W.
+ *
+ * @return true if a learned point draws at least this power.
+ */
+bool PowerModel::isCalibrated(float power) const
+{
+    for (uint8_t i = 0; i < POWER_BINS; i++)
+    {
+        if (bins[i].samples > 0 && bins[i].power >= power)
+            return true;
+    }
+
+    return false;
+}
+
+/**
+ * @brief Retrieves a bin of the curve.
+ *
+ * @param index The index of the bin (below POWER_BINS).
+ *
+ * @return The bin, samples is zero if it was not learned yet.
+ */
+const PowerModel::Bin& PowerModel::getBin(uint8_t index) const
+{
+    return bins[index];
+}
+
+/**
+ * @brief Restores a bin of the curve, e.g. from a state snapshot of a capture.
+ *
+ * The bin is not stored in the NVS until the next learned pair.
+ *
+ * @param index The index of the bin (below POWER_BINS).
+ * @param bin The bin.
+ */
+void PowerModel::setBin(uint8_t index, const Bin& bin)
+{
+    if (index < POWER_BINS)
+        bins[index] = bin;
+}
+
+/**
+ * @brief Retrieves the count of learned pairs since boot.
+ *
+ * @return The count of pairs.
+ */
+uint32_t PowerModel::getSamples() const
+{
+    return samples;
+}
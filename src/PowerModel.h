@@ -0,0 +1,62 @@
+//
+// Created by JanHe on 16.10.2026.
+//
+
+#ifndef POWERMODEL_H
+#define POWERMODEL_H
+
+#include <Arduino.h>
+
+// Count of Duty Bins of the learned Power Curve.
+#define POWER_BINS 16
+
+
+/**
+ * @class PowerModel
+ * @brief Learns the duty to power curve of the heater from its own meter.
+ *
+ * The phase angle control of the SCR is strongly non-linear, so the duty range is split
+ * into POWER_BINS bins. Every settled pair of duty and measured power updates the mean
+ * duty and power of its bin with a gain of 1/8. Between the learned points (and the
+ * origin) the curve is interpolated linearly, outside of them it is extrapolated
+ * proportionally, and without any point the initial slope is used. The curve is stored
+ * in the NVS, so it survives a reboot.
+ */
+class PowerModel
+{
+public:
+    /**
+     * @struct Bin
+     * @brief A learned point of the curve.
+     */
+    struct Bin
+    {
+        float duty;
+        float power;
+        uint16_t samples;
+    };
+
+    PowerModel(float slope, uint32_t minDuty, uint32_t range);
+    void begin(const char* name);
+    void learn(uint32_t duty, float power);
+    void save();
+    float toDuty(float power) const;
+    float toPower(float duty) const;
+    bool isCalibrated(float power) const;
+    const Bin& getBin(uint8_t index) const;
+    void setBin(uint8_t index, const Bin& bin);
+    uint32_t getSamples() const;
+
+private:
+    uint8_t collect(float* duties, float* powers) const;
+    const char* name = nullptr;
+    float slope;
+    uint32_t minDuty;
+    uint32_t range;
+    Bin bins[POWER_BINS] = {};
+    uint32_t samples = 0;
+    bool dirty = false;
+};
+
+
+#endif //POWERMODEL_H
@@ -0,0 +1,142 @@
+//
+// Created by JanHe on 16.10.2026.
+//
+
+#include "ReadPlanner.h"
+#include "MeterRegisters.h"
+#include "PinOut.h"
+
+/**
+ * @brief Plans the block requests for a list of wanted registers.
+ *
+ * The given register addresses are sorted in place and merged into blocks. A register
+ * is appended to the current block if the gap between the end of the block and the
+ * register start does not exceed the given gap and the block stays below MODBUS_BLOCK_MAX
+ * registers. The size of every register is taken from the register map of the device.
+ * Duplicate addresses are ignored.
+ *
+ * @param registers The wanted register start addresses (sorted in place).
+ * @param count The count of wanted registers.
+ * @param gap The max. count of unused registers between two wanted registers in one block.
+ * @param blocks The output buffer for the planned blocks.
+ * @param maxBlocks The size of the output buffer.
+ * @param map The register map of the device.
+ *
+ * @return The count of planned blocks.
+ */
+uint8_t ReadPlanner::plan(uint16_t* registers, uint8_t count, uint16_t gap, Block* blocks, uint8_t maxBlocks,
+                          const RegisterMap& map)
+{
+    // Sort Registers by Address (Lists are tiny, Insertion Sort is enough).
+    for (uint8_t i = 1; i < count; i++)
+    {
+        uint16_t value = registers[i];
+        int16_t j = i - 1;
+
+        while (j >= 0 && registers[j] > value)
+        {
+            registers[j + 1] = registers[j];
+            j--;
+        }
+
+        registers[j + 1] = value;
+    }
+
+    uint8_t planned = 0;
+
+    for (uint8_t i = 0; i < count; i++)
+    {
+        uint16_t address = registers[i];
+
+        if (planned > 0)
+        {
+            Block& last = blocks[planned - 1];
+            uint16_t end = last.address + last.length;
+
+            // Skip Duplicates.
+            if (address < end)
+                continue;
+
+            // Append to last Block if Gap and Block Size allow it.
+            if (address - end <= gap && (address + wordsOf(address, map)) - last.address <= MODBUS_BLOCK_MAX)
+            {
+                last.length = (address + wordsOf(address, map)) - last.address;
+
+                continue;
+            }
+        }
+
+        // No Space left for another Block.
+        if (planned >= maxBlocks)
+            break;
+
+        // Start new Block (the Device is assigned by the Caller).
+        blocks[planned] = {address, wordsOf(address, map), 0};
+        planned++;
+    }
+
+    return planned;
+}
+
+/**
+ * @brief Encodes a block into a Modbus request token.
+ *
+ * The lower 16 bit contain the start address, bit 16 - 21 the register count and
+ * bit 22 - 25 the device index. Bit 26 - 30 are reserved for the connection generation
+ * (see TOKEN_GENERATION) and bit 31 for the baud rate negotiation (see BAUD_TOKEN).
+ *
+ * @param block The block to encode.
+ *
+ * @return The token for the block request.
+ */
+uint32_t ReadPlanner::toToken(const Block& block)
+{
+    return (static_cast<uint32_t>(block.device & 0x0F) << 22) | (static_cast<uint32_t>(block.length & 0x3F) << 16) |
+        block.address;
+}
+
+/**
+ * @brief Decodes a Modbus request token back into a block.
+ *
+ * @param token The token of the block request.
+ *
+ * @return The block described by the token.
+ */
+ReadPlanner::Block ReadPlanner::fromToken(uint32_t token)
+{
+    return {
+        static_cast<uint16_t>(token & 0xFFFF), static_cast<uint16_t>((token >> 16) & 0x3F),
+        static_cast<uint8_t>((token >> 22) & 0x0F)
+    };
+}
+
+/**
+ * @brief Checks whether a register is completely covered by a block.
+ *
+ * The size of the register is taken from the register map of the device of the block.
+ *
+ * @param block The block to check.
+ * @param address The register start address.
+ *
+ * @return true if the whole register is part of the block.
+ */
+bool ReadPlanner::contains(const Block& block, uint16_t address)
+{
+    const RegisterMap& map = METER_DEVICES[block.device < METER_DEVICE_COUNT ? block.device : 0].map;
+
+    return address >= block.address && address + wordsOf(address, map) <= block.address + block.length;
+}
+
+/**
+ * @brief Calculates the byte offset of a register inside a block response.
+ *
+ * @param block The block of the response.
+ * @param address The register start address.
+ *
+ * @return The byte offset of the register inside the response message.
+ */
+uint16_t ReadPlanner::offsetOf(const Block& block, uint16_t address)
+{
+    // Server ID / Function Code / Byte Count + 2 Bytes per Register.
+    return MODBUS_OFFSET + (address - block.address) * 2;
+}
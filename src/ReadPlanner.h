@@ -0,0 +1,53 @@
+//
+// Created by JanHe on 16.10.2026.
+//
+
+#ifndef READPLANNER_H
+#define READPLANNER_H
+
+#include <Arduino.h>
+
+#include "MeterRegisters.h"
+#include "PinOut.h"
+
+// Connection Generation of a Token (Bit 26 - 30, see ModbusScheduler::tag()).
+#define TOKEN_GENERATION 0x7C000000UL
+#define TOKEN_GENERATION_SHIFT 26
+#define TOKEN_GENERATIONS 32
+
+static_assert(MODBUS_BLOCK_MAX < 0x40, "MODBUS_BLOCK_MAX must fit into the Register Count of the Token");
+
+/**
+ * @class ReadPlanner
+ * @brief Merges single register reads into as few Modbus block requests as possible.
+ *
+ * Every register the firmware needs is collected and sorted by address. Registers which
+ * are closer than the configured gap to the previous one are merged into the same block,
+ * so one RTU round trip serves multiple values. The block is encoded into the request
+ * token together with the index of the device, which allows the response handler to split
+ * the block back into single values of the right device.
+ */
+class ReadPlanner
+{
+public:
+    /**
+     * @struct Block
+     * @brief Describes a single block request (start address, count of registers and device index).
+     */
+    struct Block
+    {
+        uint16_t address;
+        uint16_t length;
+        uint8_t device;
+    };
+
+    static uint8_t plan(uint16_t* registers, uint8_t count, uint16_t gap, Block* blocks, uint8_t maxBlocks,
+                        const RegisterMap& map);
+    static uint32_t toToken(const Block& block);
+    static Block fromToken(uint32_t token);
+    static bool contains(const Block& block, uint16_t address);
+    static uint16_t offsetOf(const Block& block, uint16_t address);
+};
+
+
+#endif //READPLANNER_H
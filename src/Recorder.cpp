@@ -0,0 +1,60 @@
+//
+// Created by JanHe on 16.10.2026.
+//
+
+#include "Recorder.h"
+
+#include "Guardian.h"
+#include "PinOut.h"
+
+// Names of the Outputs in the Capture.
+const char* OUTPUT_NAMES[] = {"duty", "scr", "pump"};
+
+// Store last printed Value of every Output.
+float recordedOutputs[] = {NAN, NAN, NAN};
+
+
+/**
+ * @brief Records an input of the controller.
+ *
+ * @param kind The kind of the input (e.g. "power", "house", "ha_mode").
+ * @param value The value of the input.
+ */
+void Recorder::input(const char* kind, float value)
+{
+#if CAPTURE
+    print(kind, value);
+#endif
+}
+
+/**
+ * @brief Records an output decision if it differs from the last recorded one.
+ *
+ * @param output The output.
+ * @param value The new value of the output.
+ */
+void Recorder::output(Output output, float value)
+{
+#if CAPTURE
+    if (recordedOutputs[output] == value)
+        return;
+
+    recordedOutputs[output] = value;
+
+    print(OUTPUT_NAMES[output], value);
+#endif
+}
+
+/**
+ * @brief Prints a capture line.
+ *
+ * @param kind The kind of the line.
+ * @param value The value.
+ */
+void Recorder::print(const char* kind, float value)
+{
+    char buffer[64];
+    snprintf(buffer, sizeof(buffer), "@C,%lu,%s,%.3f", millis(), kind, value);
+
+    Guardian::println(buffer);
+}
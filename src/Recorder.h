@@ -0,0 +1,41 @@
+//
+// Created by JanHe on 16.10.2026.
+//
+
+#ifndef RECORDER_H
+#define RECORDER_H
+
+#include <Arduino.h>
+
+
+/**
+ * @class Recorder
+ * @brief Prints the inputs and output decisions of the controller as capture lines.
+ *
+ * Every line has the form "@C,<millis>,<kind>,<value>" and may appear anywhere in a
+ * Serial or WebSerial log, so the replay of tools/plant_sim can pick the lines out of
+ * a field log and drive the Watcher with exactly the same inputs. Inputs (meter
+ * samples, temperatures, flow, buttons, HA commands) are printed on every call, the
+ * outputs (duty, SCR, pump) only on change. Without CAPTURE nothing is printed.
+ */
+class Recorder
+{
+public:
+    /**
+     * @enum Output
+     * @brief The output decisions of the controller.
+     */
+    enum Output
+    {
+        DUTY, SCR, PUMP
+    };
+
+    static void input(const char* kind, float value);
+    static void output(Output output, float value);
+
+private:
+    static void print(const char* kind, float value);
+};
+
+
+#endif //RECORDER_H
@@ -0,0 +1,104 @@
+//
+// Created by JanHe on 16.10.2026.
+//
+
+#include "RegisterCodec.h"
+
+/**
+ * @brief Decodes a single register from raw big-endian Modbus bytes.
+ *
+ * @param data Pointer to the first byte of the register inside the response.
+ * @param reg The descriptor of the register.
+ *
+ * @return The decoded and scaled value.
+ */
+float RegisterCodec::decode(const uint8_t* data, const RegisterDescriptor& reg)
+{
+    // Every Modbus Word is Big-Endian.
+    uint32_t raw = (static_cast<uint32_t>(data[0]) << 8) | data[1];
+
+    if (reg.words == 2)
+    {
+        uint32_t low = (static_cast<uint32_t>(data[2]) << 8) | data[3];
+
+        // Swap Words if the low Word is sent first.
+        if (reg.order == WordOrder::HIGH_FIRST)
+            raw = (raw << 16) | low;
+        else
+            raw = (low << 16) | raw;
+    }
+
+    float value;
+
+    switch (reg.type)
+    {
+    case RegisterType::FLOAT32:
+        memcpy(&value, &raw, sizeof(value));
+        break;
+    case RegisterType::INT16:
+        value = static_cast<int16_t>(raw);
+        break;
+    case RegisterType::INT32:
+        value = static_cast<int32_t>(raw);
+        break;
+    default:
+        value = raw;
+        break;
+    }
+
+    return value * reg.scale;
+}
+
+/**
+ * @brief Encodes a single register into raw big-endian Modbus bytes.
+ *
+ * @param value The value to encode (the scale of the register is removed).
+ * @param data Pointer to the first byte of the register inside the message.
+ * @param reg The descriptor of the register.
+ */
+void RegisterCodec::encode(float value, uint8_t* data, const RegisterDescriptor& reg)
+{
+    value = value / reg.scale;
+
+    uint32_t raw;
+
+    switch (reg.type)
+    {
+    case RegisterType::FLOAT32:
+        memcpy(&raw, &value, sizeof(raw));
+        break;
+    case RegisterType::INT16:
+        raw = static_cast<uint16_t>(static_cast<int16_t>(value));
+        break;
+    case RegisterType::INT32:
+        raw = static_cast<uint32_t>(static_cast<int32_t>(value));
+        break;
+    default:
+        raw = static_cast<uint32_t>(value);
+        break;
+    }
+
+    if (reg.words == 2)
+    {
+        uint16_t high = raw >> 16;
+        uint16_t low = raw & 0xFFFF;
+
+        // Swap Words if the low Word is sent first.
+        if (reg.order == WordOrder::LOW_FIRST)
+        {
+            uint16_t swap = high;
+            high = low;
+            low = swap;
+        }
+
+        data[0] = highByte(high);
+        data[1] = lowByte(high);
+        data[2] = highByte(low);
+        data[3] = lowByte(low);
+    }
+    else
+    {
+        data[0] = highByte(raw);
+        data[1] = lowByte(raw);
+    }
+}
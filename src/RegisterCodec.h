@@ -0,0 +1,28 @@
+//
+// Created by JanHe on 16.10.2026.
+//
+
+#ifndef REGISTERCODEC_H
+#define REGISTERCODEC_H
+
+#include <Arduino.h>
+
+#include "MeterRegisters.h"
+
+
+/**
+ * @class RegisterCodec
+ * @brief Decodes raw Modbus register bytes in place into typed values and back.
+ *
+ * The type, word order and scale are taken from the RegisterDescriptor of the
+ * register, so no intermediate buffers are required.
+ */
+class RegisterCodec
+{
+public:
+    static float decode(const uint8_t* data, const RegisterDescriptor& reg);
+    static void encode(float value, uint8_t* data, const RegisterDescriptor& reg);
+};
+
+
+#endif //REGISTERCODEC_H
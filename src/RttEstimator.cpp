@@ -0,0 +1,95 @@
+//
+// Created by JanHe on 16.10.2026.
+//
+
+#include "RttEstimator.h"
+
+/**
+ * @brief Constructs an estimator with an initial timeout.
+ *
+ * @param initial The timeout in ms used until the first RTT sample arrives.
+ * @param floor The lowest timeout in ms.
+ * @param ceiling The highest timeout in ms.
+ */
+RttEstimator::RttEstimator(uint32_t initial, uint32_t floor, uint32_t ceiling)
+{
+    this->floor = floor;
+    this->ceiling = ceiling;
+    this->rto = initial;
+
+    clamp();
+}
+
+/**
+ * @brief Adds a measured round-trip time.
+ *
+ * @param rtt The round-trip time of a successful request in ms.
+ */
+void RttEstimator::sample(uint32_t rtt)
+{
+    if (!measured)
+    {
+        // First Sample (RFC 6298 2.2).
+        srtt = rtt;
+        rttvar = rtt / 2.0F;
+        measured = true;
+    }
+    else
+    {
+        // Following Samples (RFC 6298 2.3, Alpha = 1/8, Beta = 1/4).
+        rttvar = 0.75F * rttvar + 0.25F * fabsf(srtt - rtt);
+        srtt = 0.875F * srtt + 0.125F * rtt;
+    }
+
+    rto = static_cast<uint32_t>(srtt + 4.0F * rttvar);
+
+    clamp();
+}
+
+/**
+ * @brief Backs off the timeout after a request timed out.
+ */
+void RttEstimator::timeout()
+{
+    rto = rto * 2;
+
+    clamp();
+}
+
+/**
+ * @brief Retrieves the current request timeout.
+ *
+ * @return The timeout in ms.
+ */
+uint32_t RttEstimator::getTimeout() const
+{
+    return rto;
+}
+
+/**
+ * @brief Retrieves the smoothed round-trip time.
+ *
+ * @return The SRTT in ms.
+ */
+uint32_t RttEstimator::getSmoothed() const
+{
+    return static_cast<uint32_t>(srtt);
+}
+
+/**
+ * @brief Retrieves the mean deviation of the round-trip time.
+ *
+ * @return The RTTVAR in ms.
+ */
+uint32_t RttEstimator::getVariance() const
+{
+    return static_cast<uint32_t>(rttvar);
+}
+
+/**
+ * @brief Keeps the timeout between floor and ceiling.
+ */
+void RttEstimator::clamp()
+{
+    rto = constrain(rto, floor, ceiling);
+}
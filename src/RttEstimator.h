@@ -0,0 +1,41 @@
+//
+// Created by JanHe on 16.10.2026.
+//
+
+#ifndef RTTESTIMATOR_H
+#define RTTESTIMATOR_H
+
+#include <Arduino.h>
+
+
+/**
+ * @class RttEstimator
+ * @brief Derives the request timeout of a Modbus client from its measured round-trip times.
+ *
+ * Works like the TCP retransmission timer (RFC 6298): a smoothed RTT and its mean
+ * deviation are tracked, the timeout is SRTT + 4 * RTTVAR, clamped between a floor
+ * and a ceiling. Every timeout doubles the current timeout (backoff) until the next
+ * valid sample arrives.
+ */
+class RttEstimator
+{
+public:
+    RttEstimator(uint32_t initial, uint32_t floor, uint32_t ceiling);
+    void sample(uint32_t rtt);
+    void timeout();
+    uint32_t getTimeout() const;
+    uint32_t getSmoothed() const;
+    uint32_t getVariance() const;
+
+private:
+    void clamp();
+    uint32_t floor;
+    uint32_t ceiling;
+    uint32_t rto;
+    float srtt = 0;
+    float rttvar = 0;
+    bool measured = false;
+};
+
+
+#endif //RTTESTIMATOR_H
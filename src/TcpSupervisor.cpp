@@ -0,0 +1,242 @@
+//
+// Created by JanHe on 16.10.2026.
+//
+
+#include "TcpSupervisor.h"
+
+#include "Guardian.h"
+#include "MeterRegisters.h"
+#include "PinOut.h"
+
+static_assert(MODBUS_TCP_INFLIGHT <= MODBUS_INFLIGHT_LIMIT, "MODBUS_TCP_INFLIGHT must not exceed MODBUS_INFLIGHT_LIMIT");
+static_assert(MODBUS_TCP_PROBE < MODBUS_TCP_DEAD, "MODBUS_TCP_PROBE must be shorter than MODBUS_TCP_DEAD");
+
+// Store TCP Client and its Scheduler.
+ModbusClientTCPasync* supervisedClient = nullptr;
+ModbusScheduler* supervisedScheduler = nullptr;
+
+// Store Connection State.
+TcpSupervisor::State tcpState = TcpSupervisor::CONNECTING;
+
+// Store Time of the last Response and Probe, and the current Backoff.
+unsigned long tcpLastResponse = 0;
+unsigned long tcpLastProbe = 0;
+unsigned long tcpBackoffStart = 0;
+unsigned long tcpBackoff = MODBUS_TCP_BACKOFF_MIN;
+
+// Store Responses and failed Requests in a Row (written by the TCP Client Task).
+uint32_t tcpResponses = 0;
+uint8_t tcpFailures = 0;
+
+// Store Counters.
+uint32_t tcpReconnects = 0;
+uint32_t tcpProbes = 0;
+uint8_t tcpMaxInFlight = 0;
+
+portMUX_TYPE tcpMux = portMUX_INITIALIZER_UNLOCKED;
+
+
+/**
+ * @brief Configures the in-flight limit and the idle timeout and opens the connection.
+ *
+ * @param client The Modbus TCP client of the house meter.
+ * @param scheduler The scheduler of the client.
+ */
+void TcpSupervisor::begin(ModbusClientTCPasync* client, ModbusScheduler* scheduler)
+{
+    supervisedClient = client;
+    supervisedScheduler = scheduler;
+
+    // Limit Requests in flight on one Socket.
+    client->setMaxInflightRequests(MODBUS_TCP_INFLIGHT);
+
+    // Keep the Socket open between Probes.
+    client->setIdleTimeout(MODBUS_TCP_IDLE);
+
+    client->connect();
+
+    tcpState = CONNECTING;
+    tcpLastResponse = millis();
+}
+
+/**
+ * @brief Advances the connection state machine, should be called from the loop.
+ */
+void TcpSupervisor::loop()
+{
+    unsigned long now = millis();
+
+    tcpMaxInFlight = max(tcpMaxInFlight, supervisedScheduler->getInFlight());
+
+    if (tcpState == BACKOFF)
+    {
+        if (now - tcpBackoffStart < tcpBackoff)
+            return;
+
+        // Reconnect after Backoff.
+        supervisedClient->connect();
+
+        tcpState = CONNECTING;
+        tcpLastResponse = now;
+
+        return;
+    }
+
+    portENTER_CRITICAL(&tcpMux);
+    uint32_t responses = tcpResponses;
+    uint8_t failures = tcpFailures;
+    tcpResponses = 0;
+    portEXIT_CRITICAL(&tcpMux);
+
+    if (responses > 0)
+    {
+        tcpLastResponse = now;
+
+        // Link is up, reset Backoff.
+        if (tcpState == CONNECTING)
+        {
+            Guardian::println("TCP online");
+
+            tcpState = ONLINE;
+            tcpBackoff = MODBUS_TCP_BACKOFF_MIN;
+        }
+    }
+
+    if (failures >= MODBUS_TCP_FAILURES || now - tcpLastResponse > MODBUS_TCP_DEAD)
+    {
+        disconnect();
+
+        return;
+    }
+
+    // Probe quiet Link.
+    if (now - tcpLastResponse > MODBUS_TCP_PROBE && now - tcpLastProbe > MODBUS_TCP_PROBE &&
+        supervisedScheduler->getInFlight() == 0)
+        probe();
+}
+
+/**
+ * @brief Checks if requests may be sent.
+ *
+ * @return false while the connection waits for the reconnect backoff.
+ */
+bool TcpSupervisor::isReady()
+{
+    return tcpState != BACKOFF;
+}
+
+/**
+ * @brief Closes the connection and reconnects with the next loop (no backoff).
+ *
+ * Used after the network interface was restarted, because the old socket is dead.
+ */
+void TcpSupervisor::reconnect()
+{
+    disconnect();
+
+    tcpBackoff = 0;
+}
+
+/**
+ * @brief Accounts a valid response (TCP client task).
+ */
+void TcpSupervisor::handleResponse()
+{
+    portENTER_CRITICAL(&tcpMux);
+    tcpResponses++;
+    tcpFailures = 0;
+    portEXIT_CRITICAL(&tcpMux);
+}
+
+/**
+ * @brief Accounts a failed request (TCP client task).
+ *
+ * Only timeouts and connection errors count, an exception proves the link is up.
+ *
+ * @param error The error reported by the client.
+ */
+void TcpSupervisor::handleError(Error error)
+{
+    bool failed = (error == TIMEOUT || error == IP_CONNECTION_FAILED);
+
+    portENTER_CRITICAL(&tcpMux);
+
+    if (failed && tcpFailures < UINT8_MAX)
+        tcpFailures++;
+    else if (!failed)
+        tcpResponses++;
+
+    portEXIT_CRITICAL(&tcpMux);
+}
+
+/**
+ * @brief Retrieves the counters of the connection.
+ *
+ * @return The summary.
+ */
+TcpSupervisor::Summary TcpSupervisor::getSummary()
+{
+    return {
+        tcpState, tcpReconnects, tcpProbes, supervisedScheduler->getInFlight(), tcpMaxInFlight,
+        static_cast<uint32_t>(tcpBackoff)
+    };
+}
+
+/**
+ * @brief Retrieves the name of a connection state.
+ *
+ * @param state The state.
+ *
+ * @return The name used by the HTTP layer.
+ */
+const char* TcpSupervisor::getStateName(State state)
+{
+    switch (state)
+    {
+    case ONLINE:
+        return "online";
+    case BACKOFF:
+        return "backoff";
+    default:
+        return "connecting";
+    }
+}
+
+/**
+ * @brief Closes the connection and starts the backoff.
+ *
+ * All in-flight requests are released, the wanted registers stay wanted and are sent
+ * after the reconnect. The backoff doubles if the link never came up since the last
+ * reconnect.
+ */
+void TcpSupervisor::disconnect()
+{
+    Guardian::println("TCP reconnect");
+
+    supervisedClient->disconnect(true);
+    supervisedScheduler->clear();
+
+    if (tcpState == CONNECTING)
+        tcpBackoff = min(max(tcpBackoff * 2, static_cast<unsigned long>(MODBUS_TCP_BACKOFF_MIN)),
+                         static_cast<unsigned long>(MODBUS_TCP_BACKOFF_MAX));
+
+    portENTER_CRITICAL(&tcpMux);
+    tcpResponses = 0;
+    tcpFailures = 0;
+    portEXIT_CRITICAL(&tcpMux);
+
+    tcpState = BACKOFF;
+    tcpBackoffStart = millis();
+    tcpReconnects++;
+}
+
+/**
+ * @brief Wants the power register of the house meter to check the link.
+ */
+void TcpSupervisor::probe()
+{
+    tcpLastProbe = millis();
+
+    if (supervisedScheduler->want(0, POWER_USAGE))
+        tcpProbes++;
+}
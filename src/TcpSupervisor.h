@@ -0,0 +1,72 @@
+//
+// Created by JanHe on 16.10.2026.
+//
+
+#ifndef TCPSUPERVISOR_H
+#define TCPSUPERVISOR_H
+
+#include <Arduino.h>
+
+#include "ModbusClientTCPasync.h"
+#include "ModbusMessage.h"
+#include "ModbusScheduler.h"
+
+
+/**
+ * @class TcpSupervisor
+ * @brief Manages the lifecycle of the Modbus TCP connection to the house meter.
+ *
+ * At most MODBUS_TCP_INFLIGHT requests are in flight on one socket, which stays open
+ * between the polls. Only the house power is bound to the meter yet, so there is never
+ * more than one. If the meter did not answer for MODBUS_TCP_PROBE ms, a probe read
+ * is sent. The connection is closed when nothing was received for MODBUS_TCP_DEAD ms
+ * or after MODBUS_TCP_FAILURES failed requests in a row. Reconnecting starts after a
+ * backoff of MODBUS_TCP_BACKOFF_MIN ms, which doubles on every failed reconnect (up to
+ * MODBUS_TCP_BACKOFF_MAX). Requests are held back while the link is down instead of
+ * piling up in the client queue.
+ *
+ * Responses and errors arrive in the Modbus client task, the state machine only runs
+ * in the loop.
+ */
+class TcpSupervisor
+{
+public:
+    /**
+     * @enum State
+     * @brief The state of the connection.
+     */
+    enum State
+    {
+        CONNECTING, ONLINE, BACKOFF
+    };
+
+    /**
+     * @struct Summary
+     * @brief Counters of the connection for the HTTP layer.
+     */
+    struct Summary
+    {
+        State state;
+        uint32_t reconnects;
+        uint32_t probes;
+        uint8_t inFlight;
+        uint8_t maxInFlight;
+        uint32_t backoff;
+    };
+
+    static void begin(ModbusClientTCPasync* client, ModbusScheduler* scheduler);
+    static void loop();
+    static bool isReady();
+    static void reconnect();
+    static void handleResponse();
+    static void handleError(Error error);
+    static Summary getSummary();
+    static const char* getStateName(State state);
+
+private:
+    static void disconnect();
+    static void probe();
+};
+
+
+#endif //TCPSUPERVISOR_H
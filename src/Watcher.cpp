@@ -6,26 +6,43 @@
 
 #include "PinOut.h"
 #include "DallasTemperature.h"
+#include "DutyDither.h"
 #include "Fader.h"
+#include "ControlTask.h"
+#include "ControlTrigger.h"
 #include "Guardian.h"
 #include "HomeAssistant.h"
 #include "LocalModbus.h"
 #include "OneButton.h"
 #include "OneWire.h"
+#include "PiController.h"
+#include "PowerAllocator.h"
+#include "PowerModel.h"
+#include "Recorder.h"
 #include "SimpleTimer.h"
 #include "MeterRegisters.h"
+#include "MeterSample.h"
 #include "FlowSensor.h"
+#include "HeaterChannels.h"
+#include "HousePower.h"
 #include "LocalNetwork.h"
+#include "PollPolicy.h"
 #include "WebSerial.h"
 
 #define SLOW_INTERVAL 2000
 #define PUBLISH_INTERVAL 1000
 
+// Polling Policies (Min. Interval ms / Max. Interval ms / Change Threshold).
+#define POLL_POWER 250, 2000, 50.0F
+#define POLL_CONSUMPTION 10000, 60000, 0.01F
+
 // Definitions from Header.
 Watcher::ModeType Watcher::mode = Watcher::CONSUME;
 bool Watcher::standby = true;
 bool Watcher::tempLock = false;
 bool Watcher::powerLock = false;
+bool Watcher::staleLock = false;
+Watcher::StaleAction Watcher::staleAction = Watcher::STALE_ACTION;
 float Watcher::temperatureIn = 0.0f;
 float Watcher::temperatureOut = 0.0f;
 float Watcher::maxConsume = 0.0f;
@@ -71,15 +88,59 @@ OneButton modeButton(BUTTON_MODE, false);
 Fader modeLed(LED_MODE);
 
 // Store Timer.
-SimpleTimer fastInterval(500);
 SimpleTimer slowInterval(SLOW_INTERVAL);
 
 // Publish Timer for HA to save Bandwidth.
 SimpleTimer publishInterval(PUBLISH_INTERVAL);
 
+// Store Timer of the Power Curve (NVS Writes).
+SimpleTimer curveInterval(CONTROL_FF_SAVE);
+
+// Store Timer of the State Snapshot in the Capture.
+SimpleTimer stateInterval(CAPTURE_STATE);
+
 // Store Read State.
 bool readTimer = false;
 
+// Store Polling Policies of the Meter Registers.
+PollPolicy powerPolicy(POLL_POWER);
+PollPolicy consumptionPolicy(POLL_CONSUMPTION);
+
+// Store timestamped Meter Samples.
+MeterSample powerSample;
+MeterSample consumptionSample;
+MeterSample houseSample;
+
+// Store Trigger of the Control Steps.
+ControlTrigger controlTrigger(CONTROL_MIN_INTERVAL, CONTROL_WATCHDOG);
+
+// Store PI Controller of the DYNAMIC Mode (Grid Power Error in W to Duty).
+PiController controller(CONTROL_KP, CONTROL_KI, CONTROL_DEADBAND, 0, HEATER_RANGE);
+
+// Store Sigma-Delta Modulator of the fractional Controller Output and its Target (NAN = off).
+DutyDither dither(HEATER_RANGE);
+float ditherTarget = NAN;
+
+// Store learned Duty to Power Relation of the Heater.
+PowerModel powerModel(CONTROL_FF_SLOPE, CONTROL_FF_MIN_DUTY, HEATER_RANGE);
+
+// Store Heater Channels and the Split of the Duty across them.
+PowerAllocator allocator(HEATER_CHANNELS, HEATER_CHANNEL_COUNT, HEATER_PHASE_LIMIT);
+
+// Store applied Output (Duty, dithered Duty, SCR and Pump State and Time of the last Change).
+u_int32_t appliedDuty = 0;
+u_int32_t appliedOutput = 0;
+bool appliedSCR = false;
+bool appliedPump = false;
+unsigned long appliedAt = 0;
+
+// Store critical Error raised by the Control Step (reported by the Loop).
+volatile int criticalCode = 0;
+const char* volatile criticalTitle = nullptr;
+
+// Store Sequence of the last learned Power Sample.
+uint32_t learnedSequence = 0;
+
 // Store Flow Meter Instance (I know it's easy, but I have Time rush).
 FlowSensor meter(YFB5, FLOW_PULSE);
 
@@ -116,6 +177,9 @@ void Watcher::handleHAPublish()
         HomeAssistant::setCurrentPower(currentPower);
         HomeAssistant::setPWM(duty);
         HomeAssistant::setFlow(flowRate);
+        HomeAssistant::setModbusStats(LocalModbus::getStatsRTU(), LocalModbus::getStatsTCP());
+        HomeAssistant::setSampleAges(powerSample.getAge(), houseSample.getAge(), consumptionSample.getAge());
+        HomeAssistant::setHouseSource(HousePower::getActive()->getName(), HousePower::getActive()->getInterval());
 
         if (mode == ModeType::CONSUME)
         {
@@ -137,6 +201,57 @@ void Watcher::handleHAPublish()
     }
 }
 
+/**
+ * @brief Mirrors the SCR, pump and standby state to HomeAssistant.
+ *
+ * The control step must not block on MQTT, so the outputs are only stored there and
+ * published from the loop. HomeAssistant skips unchanged states, so this is cheap to
+ * call on every loop.
+ */
+void Watcher::handleHAStates()
+{
+    HomeAssistant::setSCR(appliedSCR);
+    HomeAssistant::setPump(appliedPump);
+    HomeAssistant::setStandby(standby);
+}
+
+/**
+ * @brief Disables the heater on a critical error and reports the error.
+ *
+ * With CONTROL_TASK the heater is disabled at once, the error is reported by the loop
+ * (see handleCritical), because the display and HomeAssistant are not task safe.
+ *
+ * @param code The error code.
+ * @param title The error message.
+ */
+void Watcher::raiseCritical(int code, const char* title)
+{
+#if CONTROL_TASK
+    setStandby(true);
+
+    criticalTitle = title;
+    criticalCode = code;
+#else
+    Guardian::setError(code, title, Guardian::CRITICAL);
+#endif
+}
+
+/**
+ * @brief Reports a critical error raised by the control step.
+ */
+void Watcher::handleCritical()
+{
+    if (criticalCode == 0)
+        return;
+
+    int code = criticalCode;
+    const char* title = criticalTitle;
+
+    criticalCode = 0;
+
+    Guardian::setError(code, title, Guardian::CRITICAL);
+}
+
 /**
  * @brief Handles the PWM control logic, managing temperatures, power, and system states.
  *
@@ -154,6 +269,7 @@ void Watcher::handleHAPublish()
  *   or CONSUME, and verifying power limits to optimize system performance.
  * - Controlling SCR and pump activation based on the current state of the system,
  *   including standby, locks, and power constraints.
+ * - Taking the configured StaleAction instead of regulating if a meter sample is stale.
  *
  * Intended to run regularly as part of the system's main or interval loop to
  * maintain operational safety and efficiency.
@@ -195,13 +311,21 @@ void Watcher::handlePWM()
             // If Temperature-Lock is not active.
             else
             {
+                // Release Stale-lock with fresh Samples.
+                if (staleLock && !isStale())
+                    staleLock = false;
+
+                // If a Meter Sample is too old to act on.
+                if (isStale())
+                {
+                    handleStaleData();
+                }
                 // If Max Power is exceeded. (currentPower > MaxPower).
-                if (checkLocalPowerLimit())
+                else if (checkLocalPowerLimit())
                 {
                     Guardian::println("MaxP");
 
-                    if (duty > 0)
-                        duty = duty - SCR_PWM_STEP;
+                    duty = (duty > SCR_PWM_STEP ? duty - SCR_PWM_STEP : 0);
                 }
                 // If currentPower < MaxPower.
                 else
@@ -217,10 +341,14 @@ void Watcher::handlePWM()
                         handleConsumeBasedDuty();
                 }
 
-                if (!standby && !tempLock && !powerLock)
+                if (!standby && !tempLock && !powerLock && !staleLock)
                 {
                     // Update PWM Value.
+#if CONTROL_DITHER
+                    setDitheredPWM();
+#else
                     setPWM(duty);
+#endif
 
                     // Enable Pump and SCR.
                     setSCR(true);
@@ -231,13 +359,65 @@ void Watcher::handlePWM()
                     setPump(isAllowedShutdown());
                     setSCR(false);
                 }
+                else if (staleLock)
+                {
+                    setSCR(false);
+                }
             }
         }
     }
     else
     {
         // Set Error Log and disable Heater.
-        Guardian::setError(55, "Overtemp", Guardian::CRITICAL);
+        raiseCritical(55, "Overtemp");
+    }
+}
+
+/**
+ * @brief Checks if any meter sample used by the current mode is too old.
+ *
+ * The local power is needed in every mode, the house power only in DYNAMIC mode and
+ * the consumption only in CONSUME mode. Every input has its own max. age, because the
+ * consumption is polled far less often than the power values.
+ *
+ * @return true if the controller must not act on the samples.
+ */
+bool Watcher::isStale()
+{
+    if (powerSample.isStale(STALE_POWER))
+        return true;
+
+    if (mode == ModeType::DYNAMIC)
+        return houseSample.isStale(STALE_HOUSE);
+
+    return consumptionSample.isStale(STALE_CONSUMPTION);
+}
+
+/**
+ * @brief Applies the configured StaleAction while meter samples are stale.
+ *
+ * Instead of ramping the duty on frozen values, the duty is held, ramped down or the
+ * SCR is disabled until fresh samples arrive. The stale lock is released again by
+ * handlePWM() with the first tick on fresh samples.
+ */
+void Watcher::handleStaleData()
+{
+    Guardian::println("Stale");
+
+    switch (staleAction)
+    {
+    case STALE_HOLD:
+        break;
+    case STALE_RAMP_DOWN:
+        if (duty > SCR_PWM_STEP)
+            duty = duty - SCR_PWM_STEP;
+        else
+            duty = 0;
+        break;
+    case STALE_STANDBY:
+        duty = 0;
+        staleLock = true;
+        break;
     }
 }
 
@@ -282,11 +462,13 @@ void Watcher::updateDisplay()
         // Show Mode State.
         Guardian::setValue(6, "Mode", (mode == ModeType::CONSUME ? "Consume" : "Dynamic"));
 
-        // Show TCP and RTU Message Queues.
+        // Show TCP and RTU Message Queues and p95 Round-Trip Time.
         if (displayFlow)
-            Guardian::setValue(7, "TCP", String(LocalModbus::getQueueTCP()).c_str());
+            Guardian::setValue(7, "TCP", (String(LocalModbus::getQueueTCP()) + " " +
+                                   String(LocalModbus::getStatsTCP().p95)).c_str(), "ms");
         else
-            Guardian::setValue(7, "RTU", String(LocalModbus::getQueueRTU()).c_str());
+            Guardian::setValue(7, "RTU", (String(LocalModbus::getQueueRTU()) + " " +
+                                   String(LocalModbus::getStatsRTU().p95)).c_str(), "ms");
 
         // Show House Power.
         Guardian::setValue(8, "Phouse", String(housePower, 2).c_str(), "W");
@@ -310,6 +492,8 @@ void Watcher::setFlow(float get_current_flowrate)
 {
     flowRate = get_current_flowrate;
 
+    Recorder::input("flow", get_current_flowrate);
+
     // Removed do to MQTT Timeouts.
     // HomeAssistant::setFlow(get_current_flowrate);
 }
@@ -389,8 +573,7 @@ void Watcher::calculateRemainingConsumption()
  * - Reads temperature data using a OneWire interface.
  * - Updates the temperature information in HomeAssistant for monitoring or automation purposes.
  * - Calculates and updates the flow rate based on the readings from the flow meter.
- * - Reads local power consumption data to monitor the current usage.
- * - If the system is in DYNAMIC mode, reads the active power of the house meter for real-time adjustments.
+ * - If the system is in CONSUME mode, calculates the remaining energy.
  * - Updates the OLED display with the latest information.
  *
  * Once all these operations are complete, the slow timer interval is reset to ensure proper timing
@@ -415,18 +598,9 @@ void Watcher::handleSlowInterval()
         // Set Flow Rate.
         setFlow(meter.getFlowRate_m());
 
-        // Read Local Consumption.
-        readLocalConsumption();
-
-        // Read HA Power to compensate.
-        if (mode == ModeType::DYNAMIC)
-        {
-            // Read House Meter Active Power.
-            readHouseMeterPower();
-        }
-        else
+        // Calculate remaining energy.
+        if (mode == ModeType::CONSUME)
         {
-            // Calculate remaining energy.
             calculateRemainingConsumption();
         }
 
@@ -436,38 +610,54 @@ void Watcher::handleSlowInterval()
         // Clear OneWire Errors.
         handleOneWireClearInterval();
 
+#if CAPTURE
+        // Capture the State periodically.
+        if (stateInterval.isReady())
+        {
+            recordState();
+
+            stateInterval.reset();
+        }
+#endif
+
         // Reset Timer (Endless Loop).
         slowInterval.reset();
     }
 }
 
 /**
- * @brief Handles periodic tasks executed at a fast interval for the system.
+ * @brief Runs the control step when a fresh house power sample arrived or the watchdog elapsed.
  *
- * This method is responsible for performing operations that require execution
- * within a short time interval. Specific tasks include:
- * - Reading internal power usage from the Smart Meter using `readLocalPower()`.
- * - Managing the PWM duty cycle to adjust performance based on the system state.
- * - Resetting the fast interval timer to allow continuous periodic execution.
- *
- * Designed to be called frequently to maintain real-time system responsiveness
- * for fast-changing parameters.
+ * In DYNAMIC mode with CONTROL_EVENT and CONTROL_PI every new house sample triggers a step
+ * (bounded by CONTROL_MIN_INTERVAL), so the duty reacts without waiting for a fixed tick.
+ * The fixed SCR_PWM_STEP steps don't scale with the elapsed time, so without CONTROL_PI,
+ * and without fresh samples, the step runs every CONTROL_WATCHDOG ms like the former
+ * fixed interval. The time from the arrival of a sample to the applied duty is measured.
  */
 void Watcher::handleFastInterval()
 {
-    if (fastInterval.isReady())
-    {
-        // Read internal Smart Meter Power Usage.
-        readLocalPower();
+    MeterSample::Snapshot sample = houseSample.get();
 
+    if (controlTrigger.isDue(sample, CONTROL_EVENT && CONTROL_PI && mode == ModeType::DYNAMIC))
+    {
         // Handle PWM Duty.
         handlePWM();
 
-        // Reset Timer (Endless Loop);
-        fastInterval.reset();
+        // Measure Sample to Duty Latency.
+        controlTrigger.handled(sample);
     }
 }
 
+/**
+ * @brief Retrieves the tick counters and the sample to duty latency of the controller.
+ *
+ * @return The summary of the control trigger.
+ */
+ControlTrigger::Summary Watcher::getControlSummary()
+{
+    return controlTrigger.getSummary();
+}
+
 /**
  * @brief Calculates the remaining consumption capacity.
  *
@@ -492,19 +682,21 @@ float Watcher::getRemainConsumption()
 }
 
 /**
- * @brief Reads the active power imported by the house meter and updates the house power.
+ * @brief Polls the house power sources and updates the house power.
  *
- * This method retrieves the current power reading from the house meter using the
- * LocalModbus communication interface, specifically at the POWER_IMPORT register.
- * The retrieved power value is then passed to the `setHousePower` function to update
- * the state of the system with the latest house power measurement.
+ * This method polls all enabled house power sources (Modbus TCP, MQTT, HTTP JSON) and
+ * picks the fastest healthy one. Values of the active source are passed to the
+ * `setHousePower` function to update the state of the system with the latest house
+ * power measurement.
  *
  * Used during the dynamic operational mode to compensate for external power data
  * in system calculations and ensure accurate power monitoring.
+ *
+ * @see HousePower
  */
 void Watcher::readHouseMeterPower()
 {
-    LocalModbus::readRemote(POWER_USAGE);
+    HousePower::poll();
 }
 
 /**
@@ -520,6 +712,14 @@ void Watcher::setConsumption(float con)
 {
     consumption = con;
 
+    Recorder::input("consumption", con);
+
+    // Stamp Sample.
+    consumptionSample.update(con);
+
+    // Adapt Polling Interval.
+    consumptionPolicy.update(con);
+
     HomeAssistant::setConsumption(consumption);
 }
 
@@ -534,8 +734,88 @@ void Watcher::setConsumption(float con)
  */
 void Watcher::setPWMHA(u_int32_t duty)
 {
-    // Write SCR PWM Duty via calculated Duty.
-    ledcWrite(SCR_PWM, duty);
+    // Serialize with the Control Task.
+    ControlLock lock;
+
+    // Stop dithering and drop the Residual.
+    ditherTarget = NAN;
+    dither.reset();
+
+    applyDuty(duty, duty);
+}
+
+/**
+ * @brief Applies the duty of the controller and hands its fractional output to the dither.
+ *
+ * In DYNAMIC mode the PI controller asks for a fractional duty. From now on
+ * handleDither() alternates the output between the neighbouring whole counts on every
+ * tick, so the mean power over a meter reading matches the request between two counts.
+ * Duties set by other paths (steps, limits, feed-forward or CONSUME mode) are whole
+ * counts and applied as they are.
+ */
+void Watcher::setDitheredPWM()
+{
+    float target = controller.getOutput();
+
+    // Dither only the Duty the Controller asked for.
+    if (mode != ModeType::DYNAMIC || lroundf(target) != static_cast<long>(duty))
+    {
+        setPWM(duty);
+
+        return;
+    }
+
+    char buffer[24];
+    snprintf(buffer, sizeof(buffer), "PWM: %.2f", target);
+
+    Guardian::println(buffer);
+
+    ditherTarget = target;
+
+    applyDuty(duty, dither.next(target));
+}
+
+/**
+ * @brief Advances the sigma-delta modulator of the duty (every control tick).
+ *
+ * The modulator runs faster than the control steps, so the alternating counts average
+ * out inside a single meter reading instead of showing up as ripple.
+ */
+void Watcher::handleDither()
+{
+    if (std::isnan(ditherTarget) || !appliedSCR)
+        return;
+
+    applyDuty(appliedDuty, dither.next(ditherTarget));
+}
+
+/**
+ * @brief Writes a duty to the heater channels.
+ *
+ * The settle time of the meters and the learning of the power curve refer to the whole
+ * duty, so the alternating counts of the dither don't restart the settle time.
+ *
+ * @param duty The whole duty of the controller.
+ * @param output The duty written to the channels.
+ */
+void Watcher::applyDuty(u_int32_t duty, u_int32_t output)
+{
+    // Serialize with the Control Task.
+    ControlLock lock;
+
+    // Stamp Output Change.
+    if (duty != appliedDuty)
+    {
+        appliedDuty = duty;
+        appliedAt = millis();
+    }
+
+    appliedOutput = output;
+
+    // Split the Duty across the Heater Channels.
+    allocator.allocate(output, appliedSCR);
+
+    Recorder::output(Recorder::DUTY, allocator.getDuty());
 }
 
 /**
@@ -605,10 +885,58 @@ void Watcher::readLocalConsumption()
  */
 void Watcher::handleSensors()
 {
-    handleFastInterval();
+#if !CONTROL_TASK
+    control();
+#endif
     handleSlowInterval();
 }
 
+/**
+ * @brief Runs the control path: sensor intake, learning of the power curve, control step and dither.
+ *
+ * With CONTROL_TASK this is the step of the ControlTask (fixed period, lock held),
+ * otherwise it runs inside the loop.
+ */
+void Watcher::control()
+{
+    handlePolling();
+
+    // Send the wanted Registers.
+    LocalModbus::flush();
+
+    handlePowerModel();
+    handleFastInterval();
+
+#if CONTROL_DITHER
+    handleDither();
+#endif
+}
+
+/**
+ * @brief Requests the meter registers according to their polling policies.
+ *
+ * Every register has its own PollPolicy, which tightens the interval while the value
+ * changes fast and relaxes it while the value is calm. The consumption is only read
+ * together with the local power, so both share one block request.
+ * The house meter is only polled in DYNAMIC mode.
+ */
+void Watcher::handlePolling()
+{
+    if (powerPolicy.isDue())
+    {
+        // Read internal Smart Meter Power Usage.
+        readLocalPower();
+
+        // Read Local Consumption within the same Block Request.
+        if (consumptionPolicy.isDue())
+            readLocalConsumption();
+    }
+
+    // Read House Meter Active Power to compensate.
+    if (mode == ModeType::DYNAMIC)
+        readHouseMeterPower();
+}
+
 /**
  * @brief Manages periodic tasks and updates within the main application.
  *
@@ -625,6 +953,8 @@ void Watcher::loop()
     handleSensors();
     readButtons();
     handleButtonLeds();
+    handleCritical();
+    handleHAStates();
     handleHAPublish();
 }
 
@@ -660,6 +990,8 @@ void Watcher::setupButtons()
     {
         Guardian::println("Fault L");
 
+        Recorder::input("button_fault_long", 1);
+
         Guardian::clearError();
     });
 
@@ -668,6 +1000,8 @@ void Watcher::setupButtons()
     {
         Guardian::println("Mode S");
 
+        Recorder::input("button_mode_click", 1);
+
         // Disable Standby and Handle Mode.
         startConsume();
 
@@ -681,6 +1015,8 @@ void Watcher::setupButtons()
     {
         Guardian::println("Mode L");
 
+        Recorder::input("button_mode_long", 1);
+
         setStandby(true);
         //HomeAssistant::setMode(0);
     });
@@ -719,6 +1055,17 @@ void Watcher::setup()
     // Setup Flow Meter.
     setupFlowMeter();
 
+    // Load learned Power Curve.
+    powerModel.begin("power");
+
+    // Capture the initial State.
+    recordState();
+
+#if CONTROL_TASK
+    // Start the Control Path with a fixed Period.
+    ControlTask::begin(&control);
+#endif
+
     // Print Debug Message.
     Guardian::println("Watcher ready");
 }
@@ -737,6 +1084,9 @@ void Watcher::setup()
  */
 void Watcher::setStandby(bool cond)
 {
+    // Serialize with the Control Task.
+    ControlLock lock;
+
     // Disable SCR.
     if (cond)
     {
@@ -757,8 +1107,6 @@ void Watcher::setStandby(bool cond)
 
     // Switch LED Fade vs Blink State.
     handleStandbyLedFade(cond);
-
-    HomeAssistant::setStandby(cond);
 }
 
 /**
@@ -786,8 +1134,6 @@ void Watcher::setMaxConsume(float to_float)
  */
 void Watcher::setPump(bool sender)
 {
-    HomeAssistant::setPump(sender);
-
     setPumpViaHA(sender);
 }
 
@@ -803,8 +1149,6 @@ void Watcher::setPump(bool sender)
  */
 void Watcher::setSCR(bool sender)
 {
-    HomeAssistant::setSCR(sender);
-
     setSCRViaHA(sender);
 }
 
@@ -823,7 +1167,21 @@ void Watcher::setSCR(bool sender)
  */
 void Watcher::setSCRViaHA(bool state)
 {
-    digitalWrite(SCR_ENABLE, !state);
+    // Serialize with the Control Task.
+    ControlLock lock;
+
+    // Stamp Output Change.
+    if (state != appliedSCR)
+    {
+        appliedSCR = state;
+        appliedAt = millis();
+    }
+
+    // Switch the Relays of the Heater Channels.
+    allocator.allocate(appliedOutput, state);
+
+    Recorder::output(Recorder::SCR, state);
+    Recorder::output(Recorder::DUTY, allocator.getDuty());
 }
 
 /**
@@ -838,6 +1196,13 @@ void Watcher::setSCRViaHA(bool state)
  */
 void Watcher::setPumpViaHA(bool state)
 {
+    // Serialize with the Control Task.
+    ControlLock lock;
+
+    appliedPump = state;
+
+    Recorder::output(Recorder::PUMP, state);
+
     digitalWrite(PUMP_ENABLE, !state);
 }
 
@@ -854,6 +1219,9 @@ void Watcher::setPumpViaHA(bool state)
  */
 void Watcher::startConsume()
 {
+    // Serialize with the Control Task.
+    ControlLock lock;
+
     setStandby(false);
 
     if (mode == ModeType::CONSUME)
@@ -897,6 +1265,9 @@ void Watcher::setMaxPower(float to_float)
  */
 void Watcher::setMode(ModeType cond)
 {
+    // Serialize with the Control Task.
+    ControlLock lock;
+
     duty = 0;
 
     setPWM(duty);
@@ -1017,6 +1388,14 @@ void Watcher::setPower(float current_power)
 {
     currentPower = current_power;
 
+    Recorder::input("power", current_power);
+
+    // Stamp Sample.
+    powerSample.update(current_power);
+
+    // Adapt Polling Interval.
+    powerPolicy.update(current_power);
+
     // Removed do to MQTT Timeouts.
     // HomeAssistant::setCurrentPower(current_power);
 }
@@ -1050,6 +1429,11 @@ void Watcher::readLocalPower()
 void Watcher::setHousePower(float house_power)
 {
     housePower = house_power;
+
+    Recorder::input("house", house_power);
+
+    // Stamp Sample.
+    houseSample.update(house_power);
 }
 
 /**
@@ -1166,11 +1550,13 @@ void Watcher::setupPins()
     pinMode(LED_MODE, OUTPUT);
     pinMode(LED_FAULT, OUTPUT);
     pinMode(PUMP_ENABLE, OUTPUT);
-    pinMode(SCR_ENABLE, OUTPUT);
-    pinMode(SCR_PWM, OUTPUT);
 
-    // Set PWM Frequency.
-    ledcAttach(SCR_PWM, SCR_PWM_FREQUENCY, SCR_PWM_RESOLUTION);
+    // Set SCR Pins and PWM Frequency of all Heater Channels.
+    allocator.begin();
+
+    // Limit the Controller to the Channels inside the Phase Limits.
+    controller.setLimits(0, allocator.getCapacity());
+    dither.setMaximum(allocator.getCapacity());
 
     // Set Default States.
     setDefaults();
@@ -1222,6 +1608,8 @@ void Watcher::readTemperature()
         {
             float tempC = sensors.getTempCByIndex(i);
 
+            Recorder::input(i == 0 ? "temp0" : "temp1", tempC);
+
             // Check if temp Temperature is Set.
             if (tempTemperature == -1)
             {
@@ -1332,9 +1720,14 @@ void Watcher::handleStandbyCounterEnable()
  *
  * Designed for dynamic control in power balancing systems by adapting the duty
  * cycle to reflect the current power state.
+ *
+ * With CONTROL_PI the duty is calculated by handleControllerDuty() instead.
  */
 void Watcher::handlePowerBasedDuty()
 {
+#if CONTROL_PI
+    handleControllerDuty();
+#else
     // If Generation is a negative Value.
     // Eq. Exporting
     if (isEnoughPowerGeneration())
@@ -1342,7 +1735,7 @@ void Watcher::handlePowerBasedDuty()
         handleStandbyCounterEnable();
 
         // If Power is producing/exporting like -1000 W
-        if (duty < SCR_PWM_RANGE)
+        if (duty < allocator.getCapacity())
             duty = duty + SCR_PWM_STEP;
     }
     // If Generation is a positive Value.
@@ -1355,6 +1748,288 @@ void Watcher::handlePowerBasedDuty()
 
         handleStandbyCounterDisable();
     }
+#endif
+}
+
+/**
+ * @brief Calculates the duty of the DYNAMIC mode with the PI controller.
+ *
+ * The controller drives the house power to CONTROL_SETPOINT. The power lock is counted
+ * up while the controller sits at zero duty (nothing to absorb) and counted down while
+ * the export reaches the min. power. While locked or in standby the controller restarts
+ * at zero duty, so it does not wind up on a heater which can't react. Duty changes of
+ * other parts (power limit, stale handling) are taken over before each step.
+ *
+ * With CONTROL_FF an error above CONTROL_FF_BAND restarts the controller at the duty
+ * which balances it (measured heater power plus error, mapped by the learned PowerModel),
+ * the PI terms only trim the residual. Such a jump waits until both meters show the last
+ * output change, otherwise the same deficit would be corrected twice. Until then the PI
+ * runs as usual instead of holding the duty.
+ */
+void Watcher::handleControllerDuty()
+{
+    if (isEnoughPowerGeneration())
+        handleStandbyCounterEnable();
+    else if (duty == 0)
+        handleStandbyCounterDisable();
+
+    // Hold Controller while the Heater can't act.
+    if (standby || powerLock)
+    {
+        duty = 0;
+        controller.reset(0);
+
+        return;
+    }
+
+    controller.track(duty);
+
+    float error = CONTROL_SETPOINT - housePower;
+
+#if CONTROL_FF
+    // Jump to the Duty which balances a large Deficit, the PI only trims the Residual.
+    // Only once both Meters reflect the last Output Change, until then the PI keeps stepping.
+    if (fabsf(error) > CONTROL_FF_BAND && isSettled(powerSample.get()) && isSettled(houseSample.get()))
+    {
+        controller.reset(powerModel.toDuty(max(0.0F, currentPower + error)));
+
+        duty = lroundf(controller.getOutput());
+
+        return;
+    }
+#endif
+
+    duty = lroundf(controller.update(error));
+}
+
+/**
+ * @brief Checks if a meter sample was taken after the output settled.
+ *
+ * @param sample The sample to check.
+ *
+ * @return true if the sample arrived CONTROL_FF_SETTLE ms after the last output change.
+ */
+bool Watcher::isSettled(const MeterSample::Snapshot& sample)
+{
+    return static_cast<long>(sample.timestamp - appliedAt) >= CONTROL_FF_SETTLE;
+}
+
+/**
+ * @brief Learns the duty to power curve from every new sample of the local meter.
+ *
+ * Only samples taken while the SCR was enabled and the output settled are used. The
+ * curve is stored every CONTROL_FF_SAVE ms if it changed, to spare the flash.
+ */
+void Watcher::handlePowerModel()
+{
+    if (curveInterval.isReady())
+    {
+        powerModel.save();
+
+        curveInterval.reset();
+    }
+
+    MeterSample::Snapshot sample = powerSample.get();
+
+    if (sample.sequence == learnedSequence)
+        return;
+
+    learnedSequence = sample.sequence;
+
+    if (appliedSCR && isSettled(sample))
+        powerModel.learn(appliedDuty, sample.value);
+}
+
+/**
+ * @brief Retrieves the learned duty to power curve of the heater.
+ *
+ * @return The power model.
+ */
+const PowerModel& Watcher::getPowerModel()
+{
+    return powerModel;
+}
+
+/**
+ * @brief Restores a bin of the learned duty to power curve (replay of a capture).
+ *
+ * @param index The index of the bin (below POWER_BINS).
+ * @param bin The bin.
+ */
+void Watcher::setPowerBin(uint8_t index, const PowerModel::Bin& bin)
+{
+    powerModel.setBin(index, bin);
+}
+
+/**
+ * @brief Restores the terms of the PI controller (replay of a capture).
+ *
+ * @param proportional The proportional term.
+ * @param integral The integral term.
+ */
+void Watcher::setControllerState(float proportional, float integral)
+{
+    controller.restore(proportional, integral);
+}
+
+/**
+ * @brief Restores the applied outputs and the time of their last change (replay of a
+ * capture).
+ *
+ * The feed-forward waits until the meters settled after this change (see isSettled()).
+ *
+ * @param duty The applied duty.
+ * @param scr The applied SCR state.
+ * @param age The time since the outputs changed in ms.
+ */
+void Watcher::restoreApplied(u_int32_t duty, bool scr, unsigned long age)
+{
+    // Serialize with the Control Task.
+    ControlLock lock;
+
+    appliedDuty = duty;
+    appliedOutput = duty;
+    appliedSCR = scr;
+    appliedAt = millis() - age;
+
+    allocator.allocate(appliedOutput, appliedSCR);
+}
+
+/**
+ * @brief Restores a meter sample with its age (replay of a capture).
+ *
+ * Unlike the setters of the meters, nothing is recorded or learned, the field device
+ * already did this when the value arrived.
+ *
+ * @param type The sample.
+ * @param value The meter value.
+ * @param age The age of the value in ms.
+ */
+void Watcher::restoreSample(SampleType type, float value, unsigned long age)
+{
+    switch (type)
+    {
+    case SAMPLE_POWER:
+        currentPower = value;
+        powerSample.restore(value, age);
+        break;
+    case SAMPLE_HOUSE:
+        housePower = value;
+        houseSample.restore(value, age);
+        break;
+    case SAMPLE_CONSUMPTION:
+        consumption = value;
+        consumptionSample.restore(value, age);
+        break;
+    }
+}
+
+/**
+ * @brief Retrieves the heater channels and their split of the duty.
+ *
+ * @return The allocator.
+ */
+const PowerAllocator& Watcher::getAllocator()
+{
+    return allocator;
+}
+
+/**
+ * @brief Records the settings, the duty and the learned power curve as capture lines
+ * (see Recorder).
+ *
+ * The snapshot lets a replay of a log which starts in the middle of a run begin from the
+ * same mode, limits, gains, PI terms, applied outputs, meter samples and curve as the
+ * field device. The curve is loaded from the
+ * NVS before the first snapshot, which the replay starts from, so the replay maps watts
+ * to duty like the field device. Only learned bins are recorded.
+ */
+void Watcher::recordState()
+{
+    Recorder::input("state_mode", mode);
+    Recorder::input("state_standby", standby);
+    Recorder::input("state_target", temperatureMax);
+    Recorder::input("state_maxpower", maxPower);
+    Recorder::input("state_minpower", minPower);
+    Recorder::input("state_maxconsume", maxConsume);
+    Recorder::input("state_gainp", controller.getProportional());
+    Recorder::input("state_gaini", controller.getIntegral());
+    Recorder::input("state_deadband", controller.getDeadband());
+    Recorder::input("state_duty", duty);
+    Recorder::input("state_pi_p", controller.getProportionalTerm());
+    Recorder::input("state_pi_i", controller.getIntegralTerm());
+    Recorder::input("state_applied", appliedDuty);
+    Recorder::input("state_scr", appliedSCR);
+    Recorder::input("state_applied_age", millis() - appliedAt);
+
+#if CAPTURE
+    const char* names[] = {"state_power", "state_house", "state_consumption"};
+    MeterSample* samples[] = {&powerSample, &houseSample, &consumptionSample};
+
+    for (uint8_t i = 0; i < 3; i++)
+    {
+        MeterSample::Snapshot sample = samples[i]->get();
+
+        if (sample.sequence == 0)
+            continue;
+
+        char kind[24];
+
+        Recorder::input(names[i], sample.value);
+
+        snprintf(kind, sizeof(kind), "%s_age", names[i]);
+        Recorder::input(kind, millis() - sample.timestamp);
+    }
+
+    for (uint8_t i = 0; i < POWER_BINS; i++)
+    {
+        const PowerModel::Bin& bin = powerModel.getBin(i);
+
+        if (bin.samples == 0)
+            continue;
+
+        char kind[24];
+
+        snprintf(kind, sizeof(kind), "state_bin%u_duty", i);
+        Recorder::input(kind, bin.duty);
+
+        snprintf(kind, sizeof(kind), "state_bin%u_power", i);
+        Recorder::input(kind, bin.power);
+
+        snprintf(kind, sizeof(kind), "state_bin%u_samples", i);
+        Recorder::input(kind, bin.samples);
+    }
+#endif
+}
+
+/**
+ * @brief Sets the proportional gain of the PI controller.
+ *
+ * @param gain The gain in duty per W.
+ */
+void Watcher::setGainP(float gain)
+{
+    controller.setProportional(gain);
+}
+
+/**
+ * @brief Sets the integral gain of the PI controller.
+ *
+ * @param gain The gain in duty per W and second.
+ */
+void Watcher::setGainI(float gain)
+{
+    controller.setIntegral(gain);
+}
+
+/**
+ * @brief Sets the deadband of the PI controller around the grid power setpoint.
+ *
+ * @param deadband The deadband in W.
+ */
+void Watcher::setDeadband(float deadband)
+{
+    controller.setDeadband(deadband);
 }
 
 /**
@@ -1383,6 +2058,9 @@ bool Watcher::checkLocalPowerLimit()
  * This logic helps to manage resource usage dynamically and ensures that the system
  * responds appropriately to varying power demands.
  *
+ * Once the learned power curve covers the limit, the duty is set straight to the duty
+ * of the limit instead of stepping up, the steps down stay as protection.
+ *
  * @param max_power The maximum allowable power limit to regulate against.
  */
 void Watcher::handleMaxPower(float max_power)
@@ -1394,9 +2072,16 @@ void Watcher::handleMaxPower(float max_power)
         if (duty > SCR_PWM_STEP)
             duty = duty - SCR_PWM_STEP;
     }
+    // Jump to the Duty of the learned Curve (slightly below the Limit).
+    else if (powerModel.isCalibrated(max_power))
+    {
+        long target = lroundf(powerModel.toDuty(max_power - CONTROL_DEADBAND));
+
+        duty = constrain(target, 0L, static_cast<long>(allocator.getCapacity()));
+    }
     else
     {
-        if (duty < SCR_PWM_RANGE)
+        if (duty < allocator.getCapacity())
             duty = duty + SCR_PWM_STEP;
     }
 }
@@ -1499,7 +2184,7 @@ bool Watcher::isOverTemp()
         // If Error exceeds 6 Fails, Shutdown!
         else
         {
-            Guardian::setError(100, "TempInit", Guardian::CRITICAL);
+            raiseCritical(100, "TempInit");
         }
 
         return false;
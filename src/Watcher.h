@@ -4,7 +4,11 @@
 
 #ifndef WATCHER_H
 #define WATCHER_H
+#include "ControlTrigger.h"
 #include "DallasTemperature.h"
+#include "MeterSample.h"
+#include "PowerAllocator.h"
+#include "PowerModel.h"
 
 
 /**
@@ -23,6 +27,7 @@ public:
     static bool tempLock;
     static void handleButtonLeds();
     static void loop();
+    static void control();
     static void setDefaults();
     static void setup();
     static void setStandby(bool cond);
@@ -42,8 +47,17 @@ public:
     static void handleErrorLedFade(bool cond);
     static void setDuty(u_int32_t int8);
     static void setMinPower(float to_float);
+    static void setGainP(float gain);
+    static void setGainI(float gain);
+    static void setDeadband(float deadband);
     static void setLEDColor(int r, int g, int b, int brightness);
     static void setupPins();
+    static ControlTrigger::Summary getControlSummary();
+    static const PowerModel& getPowerModel();
+    static void setPowerBin(uint8_t index, const PowerModel::Bin& bin);
+    static void setControllerState(float proportional, float integral);
+    static void restoreApplied(u_int32_t duty, bool scr, unsigned long age);
+    static const PowerAllocator& getAllocator();
 
 
     /**
@@ -62,8 +76,35 @@ public:
     };
 
 
+    /**
+     * @enum StaleAction
+     * @brief Represents the action of the controller if a meter sample is stale.
+     *
+     * - STALE_HOLD: Keeps the current duty until fresh samples arrive.
+     * - STALE_RAMP_DOWN: Decreases the duty by SCR_PWM_STEP per control tick.
+     * - STALE_STANDBY: Disables the SCR until fresh samples arrive.
+     */
+    enum StaleAction
+    {
+        STALE_HOLD, STALE_RAMP_DOWN, STALE_STANDBY
+    };
+
+
+    /**
+     * @enum SampleType
+     * @brief Represents the meter samples of the controller.
+     */
+    enum SampleType
+    {
+        SAMPLE_POWER, SAMPLE_HOUSE, SAMPLE_CONSUMPTION
+    };
+
+
     static void setMode(ModeType mode);
+    static void restoreSample(SampleType type, float value, unsigned long age);
     static ModeType mode;
+    static StaleAction staleAction;
+    static bool staleLock;
     static bool standby;
     static float maxPower;
     static float minPower;
@@ -93,6 +134,10 @@ private:
     static void handleStandbyCounterDisable();
     static void handleStandbyCounterEnable();
     static void handlePowerBasedDuty();
+    static void handleControllerDuty();
+    static bool isSettled(const MeterSample::Snapshot& sample);
+    static void handlePowerModel();
+    static void recordState();
     static bool checkLocalPowerLimit();
     static void handleMaxPower(float max_power);
     static void handleConsumeBasedDuty();
@@ -100,6 +145,11 @@ private:
     static bool isOverTemp();
     static bool isAllowedShutdown();
     static void handlePWM();
+    static void setDitheredPWM();
+    static void handleDither();
+    static void applyDuty(u_int32_t duty, u_int32_t output);
+    static bool isStale();
+    static void handleStaleData();
     static void updateDisplay();
     static void setFlow(float get_current_flowrate);
     static void updateTemperature();
@@ -109,7 +159,11 @@ private:
     static void handleFastInterval();
     static float getRemainConsumption();
     static void handleHAPublish();
+    static void handleHAStates();
+    static void raiseCritical(int code, const char* title);
+    static void handleCritical();
     static void handleSensors();
+    static void handlePolling();
     static void setupButtons();
     static void printAddress(DeviceAddress deviceAddress);
 };
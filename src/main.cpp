@@ -3,6 +3,7 @@
 
 #include "Guardian.h"
 #include "HomeAssistant.h"
+#include "HousePower.h"
 #include "LocalModbus.h"
 #include "LocalNetwork.h"
 #include "SimpleTimer.h"
@@ -49,6 +50,9 @@ void setup()
     // Begin Modbus.
     LocalModbus::begin();
 
+    // Begin House Power Sources.
+    HousePower::begin();
+
     // Setup Watcher.
     Watcher::setup();
 
@@ -95,9 +99,6 @@ void loop()
     // Loop HA.
     HomeAssistant::loop();
 
-    // Loop Modbus.
-    LocalModbus::loop();
-
     // Loop Watcher.
     Watcher::loop();
 
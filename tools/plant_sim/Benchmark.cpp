@@ -0,0 +1,174 @@
+//
+// Created by JanHe on 16.10.2026.
+//
+
+#include "Benchmark.h"
+
+#include <cmath>
+
+#include "Watcher.h"
+
+
+/**
+ * @brief Constructs the KPI collector.
+ *
+ * @param setpoint The house power the controller aims for in W.
+ * @param band The allowed deviation from the setpoint in W.
+ * @param threshold The change of load - PV in W which counts as disturbance.
+ * @param hold The time in ms the house power must stay settled.
+ */
+Benchmark::Benchmark(float setpoint, float band, float threshold, unsigned long hold)
+{
+    this->setpoint = setpoint;
+    this->band = band;
+    this->threshold = threshold;
+    this->hold = hold;
+}
+
+/**
+ * @brief Integrates the energies and tracks the disturbances of one step.
+ *
+ * @param plant The plant after the step.
+ * @param now The virtual time in ms.
+ * @param dt The length of the step in ms.
+ */
+void Benchmark::update(const Plant& plant, unsigned long now, unsigned long dt)
+{
+    double hours = dt / 3600000.0;
+    float house = plant.getHouse();
+
+    if (house < 0)
+        exported -= house * hours;
+    else
+        imported += house * hours;
+
+    pv += plant.getPv() * hours;
+    load += plant.getLoad() * hours;
+    heater += plant.getHeater() * hours;
+    absError += std::fabs(house - setpoint) * dt / 1000.0;
+    seconds += dt / 1000.0;
+
+    if (Watcher::tempLock)
+        tempLock += dt / 1000.0;
+
+    // Sample the uncontrolled House Power every Second.
+    if (first || now - lastSecond >= 1000)
+    {
+        float disturbance = plant.getLoad() - plant.getPv();
+
+        if (!first && std::fabs(disturbance - lastDisturbance) > threshold)
+        {
+            // A Ramp over several Seconds is one Disturbance, measured from its End.
+            bool ramp = open && now - eventStart <= 1000;
+
+            // A new Disturbance interrupts the last one.
+            if (open && !ramp)
+                unsettled++;
+
+            if (!ramp)
+                events++;
+
+            open = true;
+            settled = false;
+            eventStart = now;
+        }
+
+        first = false;
+        lastSecond = now;
+        lastDisturbance = disturbance;
+    }
+
+    if (!open)
+        return;
+
+    if (!isSettled(plant))
+    {
+        settled = false;
+    }
+    else if (!settled)
+    {
+        settled = true;
+        settledSince = now;
+    }
+    else if (now - settledSince >= hold)
+    {
+        close();
+    }
+}
+
+/**
+ * @brief Checks if the house power is inside the band or the heater is saturated.
+ *
+ * @param plant The plant.
+ *
+ * @return true if the controller can not do better.
+ */
+bool Benchmark::isSettled(const Plant& plant) const
+{
+    float error = plant.getHouse() - setpoint;
+
+    if (std::fabs(error) <= band)
+        return true;
+
+    // Full Heater Power while exporting.
+    if (error < 0 && plant.isSCR() && plant.getDuty() >= Watcher::getAllocator().getCapacity())
+        return true;
+
+    // Heater off while importing (or blocked by the Temperature).
+    return (error > 0 && plant.getHeater() < 1.0F) || Watcher::tempLock;
+}
+
+/**
+ * @brief Closes the open disturbance as settled.
+ */
+void Benchmark::close()
+{
+    unsigned long settling = settledSince - eventStart;
+
+    settlingSum += settling;
+    settlingMax = std::max(settlingMax, settling);
+    open = false;
+}
+
+/**
+ * @brief Writes one CSV line of the plant and controller state.
+ *
+ * @param file The CSV file.
+ * @param plant The plant.
+ * @param now The virtual time in ms.
+ */
+void Benchmark::trace(FILE* file, const Plant& plant, unsigned long now)
+{
+    fprintf(file, "%.3f,%.1f,%.1f,%.1f,%.1f,%u,%d,%d,%.2f,%.2f,%.1f,%d\n", now / 1000.0, plant.getPv(),
+            plant.getLoad(), plant.getHeater(), plant.getHouse(), plant.getDuty(), plant.isSCR(), plant.isPump(),
+            plant.getTankTemperature(), plant.getOutletTemperature(), Watcher::housePower, Watcher::tempLock);
+}
+
+/**
+ * @brief Prints the KPIs of the run.
+ *
+ * @param scrToggles The count of SCR switches.
+ * @param pumpToggles The count of pump switches.
+ * @param dutyChanges The count of duty changes.
+ */
+void Benchmark::print(uint32_t scrToggles, uint32_t pumpToggles, uint32_t dutyChanges) const
+{
+    uint32_t closed = events - unsettled - (open ? 1 : 0);
+    ControlTrigger::Summary control = Watcher::getControlSummary();
+
+    printf("PV energy          %10.1f Wh\n", pv);
+    printf("Load energy        %10.1f Wh\n", load);
+    printf("Heater energy      %10.1f Wh\n", heater);
+    printf("Exported energy    %10.1f Wh\n", exported);
+    printf("Imported energy    %10.1f Wh\n", imported);
+    printf("Mean |error|       %10.1f W\n", seconds > 0 ? absError / seconds : 0.0);
+    printf("Disturbances       %10u (%u unsettled)\n", events, events - closed);
+    printf("Settling mean      %10.1f s\n", closed > 0 ? settlingSum / closed / 1000.0 : 0.0);
+    printf("Settling max       %10.1f s\n", settlingMax / 1000.0);
+    printf("SCR toggles        %10u\n", scrToggles);
+    printf("Pump toggles       %10u\n", pumpToggles);
+    printf("Duty changes       %10u\n", dutyChanges);
+    printf("TempLock           %10.1f s\n", tempLock);
+    printf("Control ticks      %10u (%u watchdog)\n", control.events + control.watchdogs, control.watchdogs);
+    printf("Control latency    %10u ms avg, %u ms max\n", control.average, control.maximum);
+}
@@ -0,0 +1,63 @@
+//
+// Created by JanHe on 16.10.2026.
+//
+
+#ifndef BENCHMARK_H
+#define BENCHMARK_H
+
+#include <cstdint>
+#include <cstdio>
+
+#include "Plant.h"
+
+
+/**
+ * @class Benchmark
+ * @brief Collects the KPIs of a simulation run.
+ *
+ * Energies are integrated every simulation step. A disturbance is a change of the
+ * uncontrolled house power (load - PV) by more than a threshold between two seconds,
+ * changes in consecutive seconds (e.g. the edge of a cloud) form one disturbance which
+ * starts with its last change. It is settled once the house power stays inside the band around the setpoint, or
+ * the heater is saturated (full duty while exporting, off while importing), for the
+ * hold time. The settling time is measured from the disturbance to the start of that
+ * window.
+ */
+class Benchmark
+{
+public:
+    Benchmark(float setpoint, float band, float threshold, unsigned long hold);
+    void update(const Plant& plant, unsigned long now, unsigned long dt);
+    void trace(FILE* file, const Plant& plant, unsigned long now);
+    void print(uint32_t scrToggles, uint32_t pumpToggles, uint32_t dutyChanges) const;
+
+private:
+    bool isSettled(const Plant& plant) const;
+    void close();
+    float setpoint;
+    float band;
+    float threshold;
+    unsigned long hold;
+    double exported = 0;
+    double imported = 0;
+    double pv = 0;
+    double load = 0;
+    double heater = 0;
+    double tempLock = 0;
+    double absError = 0;
+    double seconds = 0;
+    float lastDisturbance = 0;
+    unsigned long lastSecond = 0;
+    bool first = true;
+    bool open = false;
+    unsigned long eventStart = 0;
+    unsigned long settledSince = 0;
+    bool settled = false;
+    uint32_t events = 0;
+    uint32_t unsettled = 0;
+    double settlingSum = 0;
+    unsigned long settlingMax = 0;
+};
+
+
+#endif //BENCHMARK_H
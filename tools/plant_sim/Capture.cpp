@@ -0,0 +1,138 @@
+//
+// Created by JanHe on 16.10.2026.
+//
+
+#include "Capture.h"
+
+#include <algorithm>
+#include <climits>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+
+#include "Recorder.h"
+
+// Names of the Outputs (see Recorder::Output).
+const char* const CAPTURE_OUTPUTS[] = {"duty", "scr", "pump"};
+
+
+/**
+ * @brief Loads the capture lines of a log file.
+ *
+ * @param path The path of the log.
+ *
+ * @return true if the file was readable and contained at least one capture line.
+ */
+bool Capture::load(const char* path)
+{
+    std::ifstream file(path);
+
+    if (!file)
+        return false;
+
+    std::string text;
+
+    while (std::getline(file, text))
+    {
+        const char* start = strstr(text.c_str(), "@C,");
+
+        if (start == nullptr)
+            continue;
+
+        unsigned long time;
+        char kind[48];
+        float value;
+
+        if (sscanf(start, "@C,%lu,%47[^,],%f", &time, kind, &value) != 3)
+            continue;
+
+        Line line = {time, kind, value};
+
+        if (outputOf(line.kind) >= 0)
+            outputs.push_back(line);
+        else
+            inputs.push_back(line);
+    }
+
+    // Keep the Order of Lines with the same Timestamp.
+    auto earlier = [](const Line& a, const Line& b) { return a.time < b.time; };
+
+    std::stable_sort(inputs.begin(), inputs.end(), earlier);
+    std::stable_sort(outputs.begin(), outputs.end(), earlier);
+
+    return !inputs.empty() || !outputs.empty();
+}
+
+/**
+ * @brief Retrieves the inputs (meters, sensors, buttons, commands and state snapshots).
+ *
+ * @return The inputs sorted by time.
+ */
+const std::vector<Capture::Line>& Capture::getInputs() const
+{
+    return inputs;
+}
+
+/**
+ * @brief Retrieves the output decisions of the field device.
+ *
+ * @return The outputs sorted by time.
+ */
+const std::vector<Capture::Line>& Capture::getOutputs() const
+{
+    return outputs;
+}
+
+/**
+ * @brief Retrieves the time of the first line.
+ *
+ * @return The time in ms.
+ */
+unsigned long Capture::getStart() const
+{
+    unsigned long start = ULONG_MAX;
+
+    if (!inputs.empty())
+        start = inputs.front().time;
+
+    if (!outputs.empty())
+        start = std::min(start, outputs.front().time);
+
+    return start;
+}
+
+/**
+ * @brief Retrieves the time of the last line.
+ *
+ * @return The time in ms.
+ */
+unsigned long Capture::getEnd() const
+{
+    unsigned long end = 0;
+
+    if (!inputs.empty())
+        end = inputs.back().time;
+
+    if (!outputs.empty())
+        end = std::max(end, outputs.back().time);
+
+    return end;
+}
+
+/**
+ * @brief Maps the kind of a line to its output.
+ *
+ * @param kind The kind of the line.
+ *
+ * @return The Recorder::Output, or -1 for inputs.
+ */
+int Capture::outputOf(const std::string& kind)
+{
+    for (int i = Recorder::DUTY; i <= Recorder::PUMP; i++)
+    {
+        if (kind == CAPTURE_OUTPUTS[i])
+            return i;
+    }
+
+    return -1;
+}
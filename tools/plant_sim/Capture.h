@@ -0,0 +1,47 @@
+//
+// Created by JanHe on 16.10.2026.
+//
+
+#ifndef CAPTURE_H
+#define CAPTURE_H
+
+#include <string>
+#include <vector>
+
+
+/**
+ * @class Capture
+ * @brief The capture lines ("@C,<millis>,<kind>,<value>") of a field log.
+ *
+ * Lines are picked out of any Serial or WebSerial log, other text around them is
+ * ignored. Inputs and output decisions (duty, scr, pump) are kept apart and sorted by
+ * time.
+ */
+class Capture
+{
+public:
+    /**
+     * @struct Line
+     * @brief A single timestamped input or output.
+     */
+    struct Line
+    {
+        unsigned long time;
+        std::string kind;
+        float value;
+    };
+
+    bool load(const char* path);
+    const std::vector<Line>& getInputs() const;
+    const std::vector<Line>& getOutputs() const;
+    unsigned long getStart() const;
+    unsigned long getEnd() const;
+    static int outputOf(const std::string& kind);
+
+private:
+    std::vector<Line> inputs;
+    std::vector<Line> outputs;
+};
+
+
+#endif //CAPTURE_H
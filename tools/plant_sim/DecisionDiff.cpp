@@ -0,0 +1,152 @@
+//
+// Created by JanHe on 16.10.2026.
+//
+
+#include "DecisionDiff.h"
+
+#include <algorithm>
+#include <cmath>
+
+#include "Recorder.h"
+
+
+/**
+ * @brief Constructs the comparison.
+ *
+ * @param tolerance The time in ms a difference may last without counting.
+ * @param dutyTolerance The allowed difference of the duty.
+ */
+DecisionDiff::DecisionDiff(unsigned long tolerance, float dutyTolerance)
+{
+    this->tolerance = tolerance;
+    this->dutyTolerance = dutyTolerance;
+}
+
+/**
+ * @brief Adds a recorded output change of the field device.
+ *
+ * @param output The Recorder::Output.
+ * @param time The time in ms.
+ * @param value The new value.
+ */
+void DecisionDiff::addField(int output, unsigned long time, float value)
+{
+    changes.push_back({output, time, value, true});
+}
+
+/**
+ * @brief Adds an output change of the replay.
+ *
+ * @param output The Recorder::Output.
+ * @param time The time in ms.
+ * @param value The new value.
+ */
+void DecisionDiff::addReplay(int output, unsigned long time, float value)
+{
+    changes.push_back({output, time, value, false});
+}
+
+/**
+ * @brief Compares an output of both sides inside a time window.
+ *
+ * Changes before the window only set the initial state of their side.
+ *
+ * @param output The Recorder::Output.
+ * @param from The start of the window in ms.
+ * @param to The end of the window in ms.
+ *
+ * @return The result of the comparison.
+ */
+DecisionDiff::Result DecisionDiff::compare(int output, unsigned long from, unsigned long to) const
+{
+    std::vector<Change> sorted;
+
+    for (const Change& change : changes)
+    {
+        if (change.output == output && change.time <= to)
+            sorted.push_back(change);
+    }
+
+    std::stable_sort(sorted.begin(), sorted.end(),
+                     [](const Change& a, const Change& b) { return a.time < b.time; });
+
+    Result result = {0, 0, 0, 0, 0, NAN, NAN};
+    float field = NAN;
+    float replay = NAN;
+    bool open = false;
+    unsigned long since = 0;
+    float sinceField = NAN;
+    float sinceReplay = NAN;
+
+    for (size_t i = 0; i <= sorted.size(); i++)
+    {
+        unsigned long time = (i < sorted.size() ? std::max(sorted[i].time, from) : to);
+
+        // Apply all Changes of the same Time before comparing.
+        if (i < sorted.size())
+        {
+            if (sorted[i].field)
+            {
+                field = sorted[i].value;
+                result.fieldChanges += (sorted[i].time >= from);
+            }
+            else
+            {
+                replay = sorted[i].value;
+                result.replayChanges += (sorted[i].time >= from);
+            }
+
+            if (i + 1 < sorted.size() && std::max(sorted[i + 1].time, from) == time)
+                continue;
+        }
+
+        bool differ = !std::isnan(field) && !std::isnan(replay) && differs(output, field, replay);
+
+        if (open && (!differ || i == sorted.size()))
+        {
+            unsigned long length = time - since;
+
+            if (length > tolerance)
+            {
+                if (result.divergences == 0)
+                {
+                    result.first = since;
+                    result.fieldValue = sinceField;
+                    result.replayValue = sinceReplay;
+                }
+
+                result.divergences++;
+                result.diverged += length;
+            }
+
+            open = false;
+        }
+
+        if (differ && !open && i < sorted.size())
+        {
+            open = true;
+            since = time;
+            sinceField = field;
+            sinceReplay = replay;
+        }
+    }
+
+    return result;
+}
+
+/**
+ * @brief Checks if two values of an output differ.
+ *
+ * @param output The Recorder::Output.
+ * @param field The value of the field device.
+ * @param replay The value of the replay.
+ *
+ * @return true if the difference is above the tolerance.
+ */
+bool DecisionDiff::differs(int output, float field, float replay) const
+{
+    if (output == Recorder::DUTY)
+        return std::fabs(field - replay) > dutyTolerance;
+
+    return field != replay;
+}
@@ -0,0 +1,63 @@
+//
+// Created by JanHe on 16.10.2026.
+//
+
+#ifndef DECISIONDIFF_H
+#define DECISIONDIFF_H
+
+#include <cstdint>
+#include <vector>
+
+
+/**
+ * @class DecisionDiff
+ * @brief Compares the output decisions of the field device with the replay.
+ *
+ * Both sides are step functions of their recorded changes. A divergence is a period in
+ * which both sides are known and differ (the duty by more than its tolerance) for
+ * longer than the time tolerance, so loop jitter of the field device does not count.
+ */
+class DecisionDiff
+{
+public:
+    /**
+     * @struct Result
+     * @brief The comparison of a single output.
+     */
+    struct Result
+    {
+        uint32_t fieldChanges;
+        uint32_t replayChanges;
+        uint32_t divergences;
+        unsigned long diverged;
+        unsigned long first;
+        float fieldValue;
+        float replayValue;
+    };
+
+    DecisionDiff(unsigned long tolerance, float dutyTolerance);
+    void addField(int output, unsigned long time, float value);
+    void addReplay(int output, unsigned long time, float value);
+    Result compare(int output, unsigned long from, unsigned long to) const;
+
+private:
+    /**
+     * @struct Change
+     * @brief A change of an output.
+     */
+    struct Change
+    {
+        int output;
+        unsigned long time;
+        float value;
+        bool field;
+    };
+
+    bool differs(int output, float field, float replay) const;
+    unsigned long tolerance;
+    float dutyTolerance;
+    std::vector<Change> changes;
+};
+
+
+#endif //DECISIONDIFF_H
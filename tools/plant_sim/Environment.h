@@ -0,0 +1,28 @@
+//
+// Created by JanHe on 16.10.2026.
+//
+
+#ifndef ENVIRONMENT_H
+#define ENVIRONMENT_H
+
+
+/**
+ * @class Environment
+ * @brief The world around the firmware, either the plant model or a recorded capture.
+ *
+ * The Fakes route every meter request and sensor read of the firmware to the active
+ * environment of the Simulation.
+ */
+class Environment
+{
+public:
+    virtual ~Environment() = default;
+    virtual void step(unsigned long now, unsigned long dt) = 0;
+    virtual void readLocal(int address) = 0;
+    virtual void pollHouse() = 0;
+    virtual float getTemperature(int index) = 0;
+    virtual float getFlow() = 0;
+};
+
+
+#endif //ENVIRONMENT_H
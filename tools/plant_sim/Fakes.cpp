@@ -0,0 +1,299 @@
+//
+// Created by JanHe on 16.10.2026.
+//
+
+// Host replacements of the firmware modules around the Watcher (display, network,
+// Modbus and Home Assistant). Everything the controller can observe of them is wired
+// to the simulation, everything else is a no-op.
+
+#include <Arduino.h>
+#include <esp_timer.h>
+
+#include "ControlTask.h"
+#include "Guardian.h"
+#include "HomeAssistant.h"
+#include "HousePower.h"
+#include "LocalModbus.h"
+#include "LocalNetwork.h"
+#include "PinOut.h"
+#include "Simulation.h"
+#include "Watcher.h"
+
+/**
+ * @class SimHouseSource
+ * @brief House power source of the simulation, the values are delivered by Simulation.
+ */
+class SimHouseSource : public HouseSource
+{
+public:
+    SimHouseSource() : HouseSource("Sim")
+    {
+    }
+
+    void poll() override
+    {
+    }
+};
+
+// Store Serial Instance.
+SimSerial Serial;
+
+// Store House Power Source.
+SimHouseSource simSource;
+
+// Store Error Code of the Guardian.
+int simError = 0;
+
+// Print Debug Messages of the Firmware.
+bool simVerbose = false;
+
+
+unsigned long millis()
+{
+    return Simulation::now();
+}
+
+unsigned long micros()
+{
+    return Simulation::now() * 1000UL;
+}
+
+void delay(unsigned long ms)
+{
+}
+
+void pinMode(uint8_t pin, uint8_t mode)
+{
+}
+
+void digitalWrite(uint8_t pin, uint8_t value)
+{
+    Simulation::handlePin(pin, value);
+}
+
+int digitalRead(uint8_t pin)
+{
+    // Buttons are pulled up.
+    return HIGH;
+}
+
+bool ledcAttach(uint8_t pin, uint32_t frequency, uint8_t resolution)
+{
+    return true;
+}
+
+bool ledcWrite(uint8_t pin, uint32_t duty)
+{
+    Simulation::handleDuty(pin, duty);
+
+    return true;
+}
+
+float simTemperature(int index)
+{
+    return Simulation::getEnvironment()->getTemperature(index);
+}
+
+float simFlowRate()
+{
+    return Simulation::getEnvironment()->getFlow();
+}
+
+void Guardian::boot(int16_t percentage, const char* str)
+{
+}
+
+void Guardian::println(const char* str)
+{
+    if (simVerbose)
+        printf("%10.3f  %s\n", Simulation::now() / 1000.0, str);
+}
+
+void Guardian::print(const char* str)
+{
+}
+
+void Guardian::setError(int i, const char* str, ErrorType level)
+{
+    simError = i;
+
+    println(str);
+
+    // Critical Errors disable everything.
+    if (level == CRITICAL)
+        Watcher::setStandby(true);
+}
+
+bool Guardian::hasError()
+{
+    return simError != 0;
+}
+
+void Guardian::clearError()
+{
+    simError = 0;
+}
+
+void Guardian::clear()
+{
+}
+
+void Guardian::setTitle(const char* str)
+{
+}
+
+void Guardian::setValue(int line, const char* key, const char* value)
+{
+}
+
+void Guardian::setValue(int16_t line, const char* key, const char* value, const char* suffix)
+{
+}
+
+void Guardian::update()
+{
+}
+
+void HomeAssistant::setFlow(float get_current_flowrate)
+{
+}
+
+void HomeAssistant::setCurrentPower(float current_power)
+{
+}
+
+void HomeAssistant::setCurrentTemperature(float x)
+{
+}
+
+void HomeAssistant::setPump(bool state)
+{
+}
+
+void HomeAssistant::setSCR(bool sender)
+{
+}
+
+void HomeAssistant::setConsumption(float value)
+{
+}
+
+void HomeAssistant::setPWM(uint32_t int8)
+{
+}
+
+void HomeAssistant::setTemperatureIn(float temperature_in)
+{
+}
+
+void HomeAssistant::setStandby(bool cond)
+{
+}
+
+void HomeAssistant::setConsumptionRemain(float value)
+{
+}
+
+void HomeAssistant::setModbusStats(const ModbusStats::Summary& rtu, const ModbusStats::Summary& tcp)
+{
+}
+
+void HomeAssistant::setSampleAges(unsigned long power, unsigned long house, unsigned long consumption)
+{
+}
+
+void HomeAssistant::setHouseSource(const char* name, unsigned long interval)
+{
+}
+
+// Store Step Function of the Control Task.
+void (*controlStep)() = nullptr;
+
+void ControlTask::begin(void (*step)())
+{
+    controlStep = step;
+
+    Simulation::addTask([](void*) { controlStep(); }, nullptr, CONTROL_TASK_PERIOD);
+}
+
+esp_err_t esp_timer_create(const esp_timer_create_args_t* args, esp_timer_handle_t* handle)
+{
+    *handle = reinterpret_cast<esp_timer_handle_t>(new esp_timer_create_args_t(*args));
+
+    return 0;
+}
+
+esp_err_t esp_timer_start_periodic(esp_timer_handle_t timer, uint64_t period)
+{
+    auto* args = reinterpret_cast<esp_timer_create_args_t*>(timer);
+
+    Simulation::addTask(args->callback, args->arg, static_cast<unsigned long>(period / 1000));
+
+    return 0;
+}
+
+void ControlTask::lock()
+{
+}
+
+void ControlTask::unlock()
+{
+}
+
+ControlTask::Summary ControlTask::getSummary()
+{
+    return {};
+}
+
+void HousePower::poll()
+{
+    Simulation::getEnvironment()->pollHouse();
+}
+
+void HousePower::handleModbus(float value)
+{
+    simSource.update(value);
+
+    Watcher::setHousePower(value);
+}
+
+HouseSource* HousePower::getActive()
+{
+    return &simSource;
+}
+
+bool LocalModbus::readLocal(int address)
+{
+    Simulation::getEnvironment()->readLocal(address);
+
+    return true;
+}
+
+void LocalModbus::flush()
+{
+}
+
+long LocalModbus::getQueueRTU()
+{
+    return 0;
+}
+
+long LocalModbus::getQueueTCP()
+{
+    return 0;
+}
+
+ModbusStats::Summary LocalModbus::getStatsRTU()
+{
+    return {};
+}
+
+ModbusStats::Summary LocalModbus::getStatsTCP()
+{
+    return {};
+}
+
+bool LocalNetwork::isUploading()
+{
+    return false;
+}
@@ -0,0 +1,307 @@
+//
+// Created by JanHe on 16.10.2026.
+//
+
+#include "Plant.h"
+
+#include <cmath>
+
+#include "PinOut.h"
+
+// Specific Heat Capacity of Water in J/(kg K).
+#define WATER_CAPACITY 4186.0F
+
+// Heat Capacity of the Water inside the Heater in J/K (about 2 Liter).
+#define HEATER_CAPACITY (2.0F * WATER_CAPACITY)
+
+// Heat Loss of the Tank in W/K and Ambient Temperature.
+#define TANK_LOSS 2.0F
+#define AMBIENT 20.0F
+
+// Duty Count of a fully fired SCR (PWM Resolution).
+#define DUTY_FULL ((1 << SCR_PWM_RESOLUTION) - 1)
+
+
+/**
+ * @brief Constructs the plant.
+ *
+ * @param config The parameters of the plant and the scenario.
+ */
+Plant::Plant(const Config& config) : config(config), random(config.seed)
+{
+    tank = config.tankStart;
+    outlet = config.tankStart;
+}
+
+/**
+ * @brief Advances the plant by a time step.
+ *
+ * @param dt The time step in ms.
+ */
+void Plant::step(unsigned long dt)
+{
+    double seconds = dt / 1000.0;
+
+    elapsed += seconds;
+
+    stepPv(config.start * 3600.0 + elapsed, seconds);
+    stepLoad(seconds);
+
+    float heater = getHeater();
+    float flow = getFlow() / 60.0F;
+
+    heaterEnergy += heater * seconds / 3600.0;
+
+    // Heater Outlet (moved Water carries the Heat into the Tank).
+    if (flow > 0)
+    {
+        outlet = tank + heater / (flow * WATER_CAPACITY);
+        tank += (heater - TANK_LOSS * (tank - AMBIENT)) * seconds / (config.tankLiters * WATER_CAPACITY);
+    }
+    // Standing Water inside the Heater (cools down to the Tank within a Minute).
+    else
+    {
+        outlet += (heater - (outlet - tank) * HEATER_CAPACITY / 60.0F) * seconds / HEATER_CAPACITY;
+        tank -= TANK_LOSS * (tank - AMBIENT) * seconds / (config.tankLiters * WATER_CAPACITY);
+    }
+}
+
+/**
+ * @brief Advances the PV generation.
+ *
+ * @param seconds The time of the day in seconds.
+ * @param dt The time step in seconds.
+ */
+void Plant::stepPv(double seconds, double dt)
+{
+    double hour = seconds / 3600.0;
+    float clear = (hour > 6.0 && hour < 18.0 ? config.pvPeak * sin(M_PI * (hour - 6.0) / 12.0) : 0.0F);
+
+    if (config.profile == "steps")
+    {
+        // Alternate between 25% and 75% of the Peak every Minute.
+        pv = (static_cast<long>(elapsed / 60.0) % 2 == 0 ? 0.25F : 0.75F) * config.pvPeak;
+
+        return;
+    }
+
+    if (config.profile == "clouds")
+    {
+        std::uniform_real_distribution<float> uniform(0.0F, 1.0F);
+
+        // A Cloud passes every 2 Minutes on Average.
+        if (uniform(random) < dt / (cloudTarget < 1.0F ? 45.0 : 120.0))
+            cloudTarget = (cloudTarget < 1.0F ? 1.0F : 0.2F + 0.5F * uniform(random));
+
+        // Edge of the Cloud.
+        cloud += (cloudTarget - cloud) * std::min(1.0, dt / 5.0);
+
+        clear *= cloud;
+    }
+
+    pv = clear;
+}
+
+/**
+ * @brief Advances the house load (base load, appliances and noise).
+ *
+ * @param dt The time step in seconds.
+ */
+void Plant::stepLoad(double dt)
+{
+    if (config.profile == "steps")
+    {
+        load = config.baseLoad;
+
+        return;
+    }
+
+    std::uniform_real_distribution<float> uniform(0.0F, 1.0F);
+
+    // An Appliance starts every 10 Minutes on Average.
+    if (applianceLeft > 0)
+        applianceLeft -= dt;
+    else if (uniform(random) < dt / 600.0)
+    {
+        appliance = 800.0F + 1700.0F * uniform(random);
+        applianceLeft = 30.0 + 570.0 * uniform(random);
+    }
+
+    if (applianceLeft <= 0)
+        appliance = 0;
+
+    // Small random Walk of the Base Load.
+    noise = std::max(-100.0F, std::min(100.0F, noise + (uniform(random) - 0.5F) * static_cast<float>(dt) * 40.0F));
+
+    load = config.baseLoad + appliance + noise;
+}
+
+/**
+ * @brief Calculates the power of a phase angle controlled heater element.
+ *
+ * @param power The rated power of the element in W.
+ * @param duty The duty of the SCR.
+ *
+ * @return The power in W.
+ */
+float Plant::curve(float power, uint32_t duty)
+{
+    float x = std::min(1.0F, static_cast<float>(duty) / DUTY_FULL);
+
+    return power * (x - sinf(2.0F * M_PI * x) / (2.0F * M_PI));
+}
+
+/**
+ * @brief Sets the SCR of a heater channel.
+ *
+ * @param index The index of the channel (see HEATER_CHANNELS).
+ * @param duty The PWM duty.
+ * @param enabled true if the SCR fires.
+ */
+void Plant::setChannel(uint8_t index, uint32_t duty, bool enabled)
+{
+    duties[index] = duty;
+    this->enabled[index] = enabled;
+}
+
+/**
+ * @brief Enables or disables the pump.
+ *
+ * @param enabled true if the pump runs.
+ */
+void Plant::setPump(bool enabled)
+{
+    pump = enabled;
+}
+
+/**
+ * @brief Retrieves the PV generation.
+ *
+ * @return The generation in W.
+ */
+float Plant::getPv() const
+{
+    return pv;
+}
+
+/**
+ * @brief Retrieves the house load without the heater.
+ *
+ * @return The load in W.
+ */
+float Plant::getLoad() const
+{
+    return load;
+}
+
+/**
+ * @brief Retrieves the power of the heater.
+ *
+ * @return The power in W.
+ */
+float Plant::getHeater() const
+{
+    float power = 0;
+
+    for (uint8_t i = 0; i < HEATER_CHANNEL_COUNT; i++)
+    {
+        if (enabled[i])
+            power += curve(HEATER_CHANNELS[i].power, duties[i]);
+    }
+
+    return power;
+}
+
+/**
+ * @brief Retrieves the power at the grid connection point.
+ *
+ * @return The power in W (negative while exporting).
+ */
+float Plant::getHouse() const
+{
+    return load + getHeater() - pv;
+}
+
+/**
+ * @brief Retrieves the energy counter of the heater meter.
+ *
+ * @return The energy in kWh.
+ */
+float Plant::getHeaterEnergy() const
+{
+    return static_cast<float>(heaterEnergy / 1000.0);
+}
+
+/**
+ * @brief Retrieves the mixed tank temperature (inlet of the heater).
+ *
+ * @return The temperature in °C.
+ */
+float Plant::getTankTemperature() const
+{
+    return tank;
+}
+
+/**
+ * @brief Retrieves the outlet temperature of the heater.
+ *
+ * @return The temperature in °C.
+ */
+float Plant::getOutletTemperature() const
+{
+    return outlet;
+}
+
+/**
+ * @brief Retrieves the flow through the heater.
+ *
+ * @return The flow in l/min.
+ */
+float Plant::getFlow() const
+{
+    return (pump ? config.flowRate : 0.0F);
+}
+
+/**
+ * @brief Retrieves the PWM duty of all enabled channels.
+ *
+ * @return The duty.
+ */
+uint32_t Plant::getDuty() const
+{
+    uint32_t duty = 0;
+
+    for (uint8_t i = 0; i < HEATER_CHANNEL_COUNT; i++)
+    {
+        if (enabled[i])
+            duty += duties[i];
+    }
+
+    return duty;
+}
+
+/**
+ * @brief Checks if any SCR fires.
+ *
+ * @return true if a channel is enabled.
+ */
+bool Plant::isSCR() const
+{
+    for (uint8_t i = 0; i < HEATER_CHANNEL_COUNT; i++)
+    {
+        if (enabled[i])
+            return true;
+    }
+
+    return false;
+}
+
+/**
+ * @brief Checks if the pump runs.
+ *
+ * @return true if the pump is enabled.
+ */
+bool Plant::isPump() const
+{
+    return pump;
+}
@@ -0,0 +1,83 @@
+//
+// Created by JanHe on 16.10.2026.
+//
+
+#ifndef PLANT_H
+#define PLANT_H
+
+#include <random>
+#include <string>
+
+#include "HeaterChannels.h"
+
+
+/**
+ * @class Plant
+ * @brief Physical model of the house, the PV system, the heater and the tank.
+ *
+ * The PV generation follows a clear sky curve over the day, optionally shaded by
+ * random clouds or replaced by hard steps for settling benchmarks. The house load is a
+ * base load with random appliances. Every heater channel (see HEATER_CHANNELS) draws
+ * the power of a phase angle controlled resistive load of its rating, the water is moved by the pump through the heater into
+ * a mixed tank. All randomness comes from the seed, so a run is reproducible.
+ */
+class Plant
+{
+public:
+    /**
+     * @struct Config
+     * @brief Parameters of the plant and the scenario.
+     */
+    struct Config
+    {
+        std::string profile = "clouds";
+        uint32_t seed = 1;
+        double start = 11.0;
+        double hours = 1.0;
+        float pvPeak = 6000.0F;
+        float baseLoad = 350.0F;
+        float tankLiters = 150.0F;
+        float tankStart = 40.0F;
+        float flowRate = 12.0F;
+    };
+
+    explicit Plant(const Config& config);
+    void step(unsigned long dt);
+    void setChannel(uint8_t index, uint32_t duty, bool enabled);
+    void setPump(bool enabled);
+    float getPv() const;
+    float getLoad() const;
+    float getHeater() const;
+    float getHouse() const;
+    float getHeaterEnergy() const;
+    float getTankTemperature() const;
+    float getOutletTemperature() const;
+    float getFlow() const;
+    uint32_t getDuty() const;
+    bool isSCR() const;
+    bool isPump() const;
+
+private:
+    static float curve(float power, uint32_t duty);
+    void stepPv(double seconds, double dt);
+    void stepLoad(double dt);
+    Config config;
+    std::mt19937 random;
+    double elapsed = 0;
+    float pv = 0;
+    float load = 0;
+    float cloud = 1.0F;
+    float cloudTarget = 1.0F;
+    float appliance = 0;
+    double applianceLeft = 0;
+    float noise = 0;
+    uint32_t duties[HEATER_CHANNEL_COUNT] = {};
+    bool enabled[HEATER_CHANNEL_COUNT] = {};
+    bool pump = false;
+    float tank;
+    float outlet;
+    double heaterEnergy = 0;
+};
+
+
+#endif //PLANT_H
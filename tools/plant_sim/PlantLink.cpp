@@ -0,0 +1,140 @@
+//
+// Created by JanHe on 16.10.2026.
+//
+
+#include "PlantLink.h"
+
+#include "HousePower.h"
+#include "MeterRegisters.h"
+#include "Simulation.h"
+#include "Watcher.h"
+
+// House Power Address of the pending Readings.
+#define HOUSE_ADDRESS (-1)
+
+
+/**
+ * @brief Constructs the link.
+ *
+ * @param plant The plant.
+ * @param meters The timing of the meters.
+ */
+PlantLink::PlantLink(Plant& plant, const Meters& meters) : plant(plant), meters(meters)
+{
+}
+
+/**
+ * @brief Applies the outputs of the firmware, advances the plant and delivers due readings.
+ *
+ * @param now The virtual time in ms.
+ * @param dt The time step in ms.
+ */
+void PlantLink::step(unsigned long now, unsigned long dt)
+{
+    this->now = now;
+
+    for (uint8_t i = 0; i < HEATER_CHANNEL_COUNT; i++)
+        plant.setChannel(i, Simulation::getChannelDuty(i), Simulation::isChannel(i));
+
+    plant.setPump(Simulation::isPump());
+    plant.step(dt);
+
+    // Keep the Steps of the measuring Window.
+    history.push_back({now, dt, plant.getHeater(), plant.getHouse()});
+
+    while (!history.empty() && now - history.front().time >= meters.window)
+        history.pop_front();
+
+    for (size_t i = 0; i < readings.size();)
+    {
+        Reading reading = readings[i];
+
+        if (reading.due > now)
+        {
+            i++;
+            continue;
+        }
+
+        readings.erase(readings.begin() + i);
+
+        if (reading.address == HOUSE_ADDRESS)
+            HousePower::handleModbus(reading.value);
+        else if (reading.address == POWER_IMPORT)
+            Watcher::setConsumption(reading.value);
+        else
+            Watcher::setPower(reading.value);
+    }
+}
+
+/**
+ * @brief Requests a register of the local RTU meter.
+ *
+ * @param address The register address.
+ */
+void PlantLink::readLocal(int address)
+{
+    float value = (address == POWER_IMPORT ? plant.getHeaterEnergy() : getMean(false));
+
+    readings.push_back({now + meters.rtuLatency, address, value});
+}
+
+/**
+ * @brief Polls the house meter in its interval.
+ */
+void PlantLink::pollHouse()
+{
+    if (now - lastPoll < meters.houseInterval)
+        return;
+
+    lastPoll = now;
+    readings.push_back({now + meters.houseLatency, HOUSE_ADDRESS, getMean(true)});
+}
+
+/**
+ * @brief Calculates the mean power over the measuring window.
+ *
+ * @param house true for the house power, false for the heater power.
+ *
+ * @return The power in W, weighted by the length of the steps.
+ */
+float PlantLink::getMean(bool house) const
+{
+    if (history.empty())
+        return (house ? plant.getHouse() : plant.getHeater());
+
+    double sum = 0;
+    unsigned long span = 0;
+
+    for (const Power& power : history)
+    {
+        sum += (house ? power.house : power.heater) * power.dt;
+        span += power.dt;
+    }
+
+    if (span == 0)
+        return (house ? history.back().house : history.back().heater);
+
+    return sum / span;
+}
+
+/**
+ * @brief Retrieves the temperature of a 1-Wire sensor.
+ *
+ * @param index The index of the sensor (0 = tank, 1 = heater outlet).
+ *
+ * @return The temperature in °C.
+ */
+float PlantLink::getTemperature(int index)
+{
+    return (index == 0 ? plant.getTankTemperature() : plant.getOutletTemperature());
+}
+
+/**
+ * @brief Retrieves the flow of the pump.
+ *
+ * @return The flow in l/min.
+ */
+float PlantLink::getFlow()
+{
+    return plant.getFlow();
+}
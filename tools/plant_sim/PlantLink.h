@@ -0,0 +1,81 @@
+//
+// Created by JanHe on 16.10.2026.
+//
+
+#ifndef PLANTLINK_H
+#define PLANTLINK_H
+
+#include <deque>
+#include <vector>
+
+#include "Environment.h"
+#include "Plant.h"
+
+
+/**
+ * @class PlantLink
+ * @brief Connects the firmware to the plant model through simulated meters.
+ *
+ * Meter reads are answered after their latency with the value measured at the time of
+ * the request, like a real meter. Power values are the mean over the measuring window
+ * of the meter, so an output which alternates faster than the window shows up as its
+ * mean. The house meter is polled in its own interval.
+ */
+class PlantLink : public Environment
+{
+public:
+    /**
+     * @struct Meters
+     * @brief Timing of the simulated meters in ms.
+     */
+    struct Meters
+    {
+        unsigned long rtuLatency = 60;
+        unsigned long houseInterval = 1000;
+        unsigned long houseLatency = 300;
+        unsigned long window = 0;
+    };
+
+    PlantLink(Plant& plant, const Meters& meters);
+    void step(unsigned long now, unsigned long dt) override;
+    void readLocal(int address) override;
+    void pollHouse() override;
+    float getTemperature(int index) override;
+    float getFlow() override;
+
+private:
+    float getMean(bool house) const;
+
+    /**
+     * @struct Power
+     * @brief The heater and house power of a time step.
+     */
+    struct Power
+    {
+        unsigned long time;
+        unsigned long dt;
+        float heater;
+        float house;
+    };
+
+    /**
+     * @struct Reading
+     * @brief A meter value on its way to the firmware.
+     */
+    struct Reading
+    {
+        unsigned long due;
+        int address;
+        float value;
+    };
+
+    Plant& plant;
+    Meters meters;
+    std::vector<Reading> readings;
+    std::deque<Power> history;
+    unsigned long now = 0;
+    unsigned long lastPoll = 0;
+};
+
+
+#endif //PLANTLINK_H
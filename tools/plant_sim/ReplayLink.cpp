@@ -0,0 +1,311 @@
+//
+// Created by JanHe on 16.10.2026.
+//
+
+#include "ReplayLink.h"
+
+#include <climits>
+#include <cstdio>
+#include <cstring>
+
+#include "HousePower.h"
+#include "OneButton.h"
+#include "PinOut.h"
+#include "Watcher.h"
+
+
+/**
+ * @brief Constructs the link and locates the start of the replay.
+ *
+ * The replay starts with the first state snapshot, or with the first input if the
+ * capture has no snapshot.
+ *
+ * @param capture The capture.
+ */
+ReplayLink::ReplayLink(const Capture& capture) : capture(capture)
+{
+    const std::vector<Capture::Line>& inputs = capture.getInputs();
+
+    start = capture.getStart();
+
+    for (size_t i = 0; i < inputs.size(); i++)
+    {
+        if (inputs[i].kind.compare(0, 6, "state_") == 0)
+        {
+            state = true;
+            stateTime = inputs[i].time;
+            start = stateTime;
+            next = i;
+
+            break;
+        }
+    }
+}
+
+/**
+ * @brief Applies all inputs which are due.
+ *
+ * @param now The virtual time in ms.
+ * @param dt The time step in ms.
+ */
+void ReplayLink::step(unsigned long now, unsigned long dt)
+{
+    const std::vector<Capture::Line>& inputs = capture.getInputs();
+
+    while (next < inputs.size() && inputs[next].time <= now)
+    {
+        apply(inputs[next]);
+
+        next++;
+    }
+}
+
+/**
+ * @brief Applies a recorded input like the firmware module which recorded it.
+ *
+ * @param line The input.
+ */
+void ReplayLink::apply(const Capture::Line& line)
+{
+    const std::string& kind = line.kind;
+    float value = line.value;
+
+    applied++;
+
+    if (kind.compare(0, 6, "state_") == 0)
+        applyState(line);
+    else if (kind == "power")
+        Watcher::setPower(value);
+    else if (kind == "consumption")
+        Watcher::setConsumption(value);
+    else if (kind == "house")
+        HousePower::handleModbus(value);
+    else if (kind == "temp0")
+        temperatures[0] = value;
+    else if (kind == "temp1")
+        temperatures[1] = value;
+    else if (kind == "flow")
+        flow = value;
+    else if (kind == "button_fault_long")
+        OneButton::simPress(BUTTON_FAULT, OneButton::LONG_PRESS);
+    else if (kind == "button_mode_click")
+        OneButton::simPress(BUTTON_MODE, OneButton::CLICK);
+    else if (kind == "button_mode_long")
+        OneButton::simPress(BUTTON_MODE, OneButton::LONG_PRESS);
+    else if (kind == "ha_pump")
+    {
+        // Manual Outputs are only accepted in Standby.
+        if (Watcher::standby)
+            Watcher::setPumpViaHA(value != 0);
+    }
+    else if (kind == "ha_scr")
+    {
+        if (Watcher::standby)
+            Watcher::setSCRViaHA(value != 0);
+    }
+    else if (kind == "ha_target")
+        Watcher::setTargetTemperature(value);
+    else if (kind == "ha_mode" && value == 0)
+        Watcher::setStandby(true);
+    else if (kind == "ha_mode")
+        Watcher::setMode(value == 1 ? Watcher::CONSUME : Watcher::DYNAMIC);
+    else if (kind == "ha_maxconsume")
+        Watcher::setMaxConsume(value);
+    else if (kind == "ha_start")
+        Watcher::startConsume();
+    else if (kind == "ha_maxpower")
+        Watcher::setMaxPower(value);
+    else if (kind == "ha_minpower")
+        Watcher::setMinPower(value);
+    else if (kind == "ha_gainp")
+        Watcher::setGainP(value);
+    else if (kind == "ha_gaini")
+        Watcher::setGainI(value);
+    else if (kind == "ha_deadband")
+        Watcher::setDeadband(value);
+    else if (kind == "ha_duty")
+    {
+        if (Watcher::standby)
+        {
+            Watcher::setDuty(value);
+            Watcher::setPWM(value);
+        }
+    }
+    else
+    {
+        applied--;
+        unknown.insert(kind);
+    }
+}
+
+/**
+ * @brief Maps the kind of a sample line of a state snapshot to its sample.
+ *
+ * @param kind The kind without "_age".
+ *
+ * @return The sample.
+ */
+Watcher::SampleType ReplayLink::sampleOf(const std::string& kind)
+{
+    if (kind == "state_house")
+        return Watcher::SAMPLE_HOUSE;
+
+    if (kind == "state_consumption")
+        return Watcher::SAMPLE_CONSUMPTION;
+
+    return Watcher::SAMPLE_POWER;
+}
+
+/**
+ * @brief Restores a value of the first state snapshot.
+ *
+ * @param line The state line.
+ */
+void ReplayLink::applyState(const Capture::Line& line)
+{
+    if (!state || line.time != stateTime)
+        return;
+
+    const std::string& kind = line.kind;
+    float value = line.value;
+    unsigned int index;
+    char field[16];
+
+    if (sscanf(kind.c_str(), "state_bin%u_%15s", &index, field) == 2 && index < POWER_BINS)
+    {
+        PowerModel::Bin& bin = curve[index];
+
+        if (strcmp(field, "duty") == 0)
+            bin.duty = value;
+        else if (strcmp(field, "power") == 0)
+            bin.power = value;
+        else if (strcmp(field, "samples") == 0)
+            bin.samples = static_cast<uint16_t>(value);
+        else
+            unknown.insert(kind);
+
+        Watcher::setPowerBin(index, bin);
+    }
+    else if (kind == "state_mode")
+        Watcher::setMode(value == Watcher::CONSUME ? Watcher::CONSUME : Watcher::DYNAMIC);
+    else if (kind == "state_standby")
+        Watcher::setStandby(value != 0);
+    else if (kind == "state_target")
+        Watcher::setTargetTemperature(value);
+    else if (kind == "state_maxpower")
+        Watcher::setMaxPower(value);
+    else if (kind == "state_minpower")
+        Watcher::setMinPower(value);
+    else if (kind == "state_maxconsume")
+        Watcher::setMaxConsume(value);
+    else if (kind == "state_gainp")
+        Watcher::setGainP(value);
+    else if (kind == "state_gaini")
+        Watcher::setGainI(value);
+    else if (kind == "state_deadband")
+        Watcher::setDeadband(value);
+    else if (kind == "state_duty")
+        Watcher::setDuty(value);
+    else if (kind == "state_power" || kind == "state_house" || kind == "state_consumption")
+        samples[sampleOf(kind)] = value;
+    else if (kind == "state_power_age" || kind == "state_house_age" || kind == "state_consumption_age")
+    {
+        Watcher::SampleType type = sampleOf(kind.substr(0, kind.size() - 4));
+
+        Watcher::restoreSample(type, samples[type], static_cast<unsigned long>(value));
+    }
+    else if (kind == "state_applied")
+        appliedDuty = value;
+    else if (kind == "state_scr")
+        appliedSCR = (value != 0);
+    else if (kind == "state_applied_age")
+        Watcher::restoreApplied(lroundf(appliedDuty), appliedSCR, static_cast<unsigned long>(value));
+    else if (kind == "state_pi_p" || kind == "state_pi_i")
+    {
+        terms[kind == "state_pi_p" ? 0 : 1] = value;
+
+        Watcher::setControllerState(terms[0], terms[1]);
+    }
+    else
+        unknown.insert(kind);
+}
+
+/**
+ * @brief Ignores a meter request, the samples come from the capture.
+ *
+ * @param address The register address.
+ */
+void ReplayLink::readLocal(int address)
+{
+}
+
+/**
+ * @brief Ignores a house meter poll, the samples come from the capture.
+ */
+void ReplayLink::pollHouse()
+{
+}
+
+/**
+ * @brief Retrieves the last recorded temperature of a 1-Wire sensor.
+ *
+ * @param index The index of the sensor.
+ *
+ * @return The temperature in °C.
+ */
+float ReplayLink::getTemperature(int index)
+{
+    return temperatures[index == 0 ? 0 : 1];
+}
+
+/**
+ * @brief Retrieves the last recorded flow.
+ *
+ * @return The flow in l/min.
+ */
+float ReplayLink::getFlow()
+{
+    return flow;
+}
+
+/**
+ * @brief Retrieves the time the replay starts at.
+ *
+ * @return The time in ms.
+ */
+unsigned long ReplayLink::getStart() const
+{
+    return start;
+}
+
+/**
+ * @brief Retrieves the time of the next input.
+ *
+ * @return The time in ms, or ULONG_MAX after the last input.
+ */
+unsigned long ReplayLink::getNext() const
+{
+    const std::vector<Capture::Line>& inputs = capture.getInputs();
+
+    return (next < inputs.size() ? inputs[next].time : ULONG_MAX);
+}
+
+/**
+ * @brief Retrieves the count of applied inputs.
+ *
+ * @return The count.
+ */
+uint32_t ReplayLink::getApplied() const
+{
+    return applied;
+}
+
+/**
+ * @brief Retrieves the kinds of lines the replay does not know.
+ *
+ * @return The kinds.
+ */
+const std::set<std::string>& ReplayLink::getUnknown() const
+{
+    return unknown;
+}
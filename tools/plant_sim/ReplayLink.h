@@ -0,0 +1,62 @@
+//
+// Created by JanHe on 16.10.2026.
+//
+
+#ifndef REPLAYLINK_H
+#define REPLAYLINK_H
+
+#include <set>
+#include <string>
+
+#include "Capture.h"
+#include "Environment.h"
+#include "PowerModel.h"
+#include "Watcher.h"
+
+
+/**
+ * @class ReplayLink
+ * @brief Feeds the recorded inputs of a capture into the firmware.
+ *
+ * Every input is applied at its recorded time, before the next Watcher::loop(). Meter
+ * requests of the firmware are ignored, the samples come from the capture. Only the
+ * first state snapshot is applied (it restores mode, limits, gains, duty, PI terms, the
+ * applied outputs, meter samples and the learned power curve of the field device), later
+ * snapshots are skipped.
+ */
+class ReplayLink : public Environment
+{
+public:
+    explicit ReplayLink(const Capture& capture);
+    void step(unsigned long now, unsigned long dt) override;
+    void readLocal(int address) override;
+    void pollHouse() override;
+    float getTemperature(int index) override;
+    float getFlow() override;
+    unsigned long getStart() const;
+    unsigned long getNext() const;
+    uint32_t getApplied() const;
+    const std::set<std::string>& getUnknown() const;
+
+private:
+    void apply(const Capture::Line& line);
+    void applyState(const Capture::Line& line);
+    static Watcher::SampleType sampleOf(const std::string& kind);
+    const Capture& capture;
+    size_t next = 0;
+    unsigned long start = 0;
+    unsigned long stateTime = 0;
+    bool state = false;
+    PowerModel::Bin curve[POWER_BINS] = {};
+    float terms[2] = {};
+    float samples[3] = {};
+    float appliedDuty = 0;
+    bool appliedSCR = false;
+    float temperatures[2] = {20.0F, 20.0F};
+    float flow = 0;
+    uint32_t applied = 0;
+    std::set<std::string> unknown;
+};
+
+
+#endif //REPLAYLINK_H
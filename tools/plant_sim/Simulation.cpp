@@ -0,0 +1,282 @@
+//
+// Created by JanHe on 16.10.2026.
+//
+
+#include "Simulation.h"
+
+#include <Arduino.h>
+
+#include "HeaterChannels.h"
+#include "PinOut.h"
+
+// Store active Environment.
+Environment* simEnvironment = nullptr;
+
+// Store virtual Time in ms.
+unsigned long simNow = 0;
+
+// Max. Count of periodic Tasks.
+#define SIM_TASKS 4
+
+/**
+ * @struct SimTask
+ * @brief A periodic task of the firmware and the time of its next tick.
+ */
+struct SimTask
+{
+    void (*callback)(void* arg);
+    void* arg;
+    unsigned long period;
+    unsigned long next;
+};
+
+// Store periodic Tasks of the Firmware.
+SimTask simTasks[SIM_TASKS] = {};
+uint8_t simTaskCount = 0;
+
+// Store Outputs of the Firmware (Heater Channels by Index of HEATER_CHANNELS).
+bool simChannels[HEATER_CHANNEL_COUNT] = {};
+uint32_t simDuties[HEATER_CHANNEL_COUNT] = {};
+bool simPump = false;
+
+// Store Output Counters.
+uint32_t simSCRToggles = 0;
+uint32_t simPumpToggles = 0;
+uint32_t simDutyChanges = 0;
+
+
+/**
+ * @brief Connects the firmware to an environment.
+ *
+ * @param environment The environment.
+ * @param start The virtual time of the start in ms.
+ */
+void Simulation::begin(Environment* environment, unsigned long start)
+{
+    simEnvironment = environment;
+    simNow = start;
+}
+
+/**
+ * @brief Advances the virtual time and the environment.
+ *
+ * The step is split at the ticks of the tasks, so every task sees the environment at the
+ * exact time of its tick. Tasks due at the same time run in the order they were added.
+ *
+ * @param dt The time step in ms.
+ */
+void Simulation::advance(unsigned long dt)
+{
+    unsigned long end = simNow + dt;
+
+    while (true)
+    {
+        SimTask* due = nullptr;
+
+        for (uint8_t i = 0; i < simTaskCount; i++)
+        {
+            if (simTasks[i].next <= end && (due == nullptr || simTasks[i].next < due->next))
+                due = &simTasks[i];
+        }
+
+        if (due == nullptr)
+            break;
+
+        if (due->next > simNow)
+        {
+            simEnvironment->step(due->next, due->next - simNow);
+            simNow = due->next;
+        }
+
+        due->next += due->period;
+        due->callback(due->arg);
+    }
+
+    if (end > simNow)
+    {
+        simEnvironment->step(end, end - simNow);
+        simNow = end;
+    }
+}
+
+/**
+ * @brief Starts a periodic task of the firmware on the virtual clock.
+ *
+ * @param callback The step function of the task.
+ * @param arg The argument of the step function.
+ * @param period The period in ms (min. 1).
+ */
+void Simulation::addTask(void (*callback)(void* arg), void* arg, unsigned long period)
+{
+    if (simTaskCount >= SIM_TASKS)
+        return;
+
+    period = (period == 0 ? 1 : period);
+
+    simTasks[simTaskCount++] = {callback, arg, period, simNow + period};
+}
+
+/**
+ * @brief Retrieves the virtual time.
+ *
+ * @return The time in ms since boot.
+ */
+unsigned long Simulation::now()
+{
+    return simNow;
+}
+
+/**
+ * @brief Retrieves the active environment.
+ *
+ * @return The environment.
+ */
+Environment* Simulation::getEnvironment()
+{
+    return simEnvironment;
+}
+
+/**
+ * @brief Applies a digital output of the firmware (SCR and pump are low active).
+ *
+ * @param pin The pin.
+ * @param value The level.
+ */
+void Simulation::handlePin(uint8_t pin, uint8_t value)
+{
+    bool enabled = (value == LOW);
+
+    if (pin == PUMP_ENABLE && simPump != enabled)
+    {
+        simPump = enabled;
+        simPumpToggles++;
+    }
+
+    for (uint8_t i = 0; i < HEATER_CHANNEL_COUNT; i++)
+    {
+        if (pin == HEATER_CHANNELS[i].enablePin && simChannels[i] != enabled)
+        {
+            simChannels[i] = enabled;
+            simSCRToggles++;
+        }
+    }
+}
+
+/**
+ * @brief Applies a PWM duty of the firmware.
+ *
+ * @param pin The PWM pin.
+ * @param duty The duty.
+ */
+void Simulation::handleDuty(uint8_t pin, uint32_t duty)
+{
+    for (uint8_t i = 0; i < HEATER_CHANNEL_COUNT; i++)
+    {
+        if (pin != HEATER_CHANNELS[i].pwmPin)
+            continue;
+
+        if (duty != simDuties[i])
+            simDutyChanges++;
+
+        simDuties[i] = duty;
+    }
+}
+
+/**
+ * @brief Checks if the SCR of the first channel (by priority) is enabled.
+ *
+ * The first channel follows the SCR state of the Watcher, further channels are staged.
+ *
+ * @return true if enabled.
+ */
+bool Simulation::isSCR()
+{
+    uint8_t first = 0;
+
+    for (uint8_t i = 1; i < HEATER_CHANNEL_COUNT; i++)
+    {
+        if (HEATER_CHANNELS[i].priority < HEATER_CHANNELS[first].priority)
+            first = i;
+    }
+
+    return simChannels[first];
+}
+
+/**
+ * @brief Checks if the pump is enabled.
+ *
+ * @return true if enabled.
+ */
+bool Simulation::isPump()
+{
+    return simPump;
+}
+
+/**
+ * @brief Retrieves the PWM duty of all channels.
+ *
+ * @return The duty.
+ */
+uint32_t Simulation::getDuty()
+{
+    uint32_t duty = 0;
+
+    for (uint8_t i = 0; i < HEATER_CHANNEL_COUNT; i++)
+        duty += simDuties[i];
+
+    return duty;
+}
+
+/**
+ * @brief Checks if the SCR of a channel is enabled.
+ *
+ * @param index The index of the channel (see HEATER_CHANNELS).
+ *
+ * @return true if enabled.
+ */
+bool Simulation::isChannel(uint8_t index)
+{
+    return simChannels[index];
+}
+
+/**
+ * @brief Retrieves the PWM duty of a channel.
+ *
+ * @param index The index of the channel (see HEATER_CHANNELS).
+ *
+ * @return The duty.
+ */
+uint32_t Simulation::getChannelDuty(uint8_t index)
+{
+    return simDuties[index];
+}
+
+/**
+ * @brief Retrieves the count of SCR switches.
+ *
+ * @return The count.
+ */
+uint32_t Simulation::getSCRToggles()
+{
+    return simSCRToggles;
+}
+
+/**
+ * @brief Retrieves the count of pump switches.
+ *
+ * @return The count.
+ */
+uint32_t Simulation::getPumpToggles()
+{
+    return simPumpToggles;
+}
+
+/**
+ * @brief Retrieves the count of duty changes.
+ *
+ * @return The count.
+ */
+uint32_t Simulation::getDutyChanges()
+{
+    return simDutyChanges;
+}
@@ -0,0 +1,44 @@
+//
+// Created by JanHe on 16.10.2026.
+//
+
+#ifndef SIMULATION_H
+#define SIMULATION_H
+
+#include <cstdint>
+
+#include "Environment.h"
+
+
+/**
+ * @class Simulation
+ * @brief Virtual clock and outputs of the firmware.
+ *
+ * The firmware sees the world only through its IO (PWM, SCR and pump pins, 1-Wire and
+ * flow sensor) and through the meters, which are answered by the active Environment.
+ * The outputs written by the firmware are kept here per heater channel, together with
+ * their switch counts. Tasks and timers started by the firmware (see ControlTask and the
+ * burst-fire timer of PowerAllocator) run exactly at their period on the virtual clock.
+ */
+class Simulation
+{
+public:
+    static void begin(Environment* environment, unsigned long start);
+    static void advance(unsigned long dt);
+    static void addTask(void (*callback)(void* arg), void* arg, unsigned long period);
+    static unsigned long now();
+    static Environment* getEnvironment();
+    static void handlePin(uint8_t pin, uint8_t value);
+    static void handleDuty(uint8_t pin, uint32_t duty);
+    static bool isSCR();
+    static bool isPump();
+    static uint32_t getDuty();
+    static bool isChannel(uint8_t index);
+    static uint32_t getChannelDuty(uint8_t index);
+    static uint32_t getSCRToggles();
+    static uint32_t getPumpToggles();
+    static uint32_t getDutyChanges();
+};
+
+
+#endif //SIMULATION_H
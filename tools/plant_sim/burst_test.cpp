@@ -0,0 +1,193 @@
+//
+// Created by JanHe on 16.10.2026.
+//
+
+// Host test of the BurstPattern (on cycles per packet, residual carry, limits and reset).
+//
+// Usage: burst_test
+//
+// Exits with 1 if a check fails.
+
+#include <Arduino.h>
+
+#include "BurstPattern.h"
+
+// Count of failed Checks.
+int failures = 0;
+
+
+/**
+ * @brief Reports a failed check.
+ *
+ * @param condition The checked condition.
+ * @param name The name of the check.
+ */
+void check(bool condition, const char* name)
+{
+    if (condition)
+        return;
+
+    fprintf(stderr, "FAIL %s\n", name);
+
+    failures++;
+}
+
+/**
+ * @brief Runs one packet and counts its on cycles.
+ *
+ * @param pattern The pattern.
+ * @param fired Receives the cycles which fired (length of the pattern), may be nullptr.
+ * @return The count of on cycles.
+ */
+uint16_t packet(BurstPattern& pattern, bool* fired)
+{
+    uint16_t count = 0;
+
+    for (uint16_t i = 0; i < pattern.getLength(); i++)
+    {
+        bool fire = pattern.next();
+
+        if (fired != nullptr)
+            fired[i] = fire;
+
+        count += fire;
+    }
+
+    return count;
+}
+
+/**
+ * @brief Checks the on cycles of one packet and their distribution.
+ */
+void testPacket()
+{
+    bool fired[10];
+
+    // Spread: 3 of 10 Cycles, never two in a Row.
+    BurstPattern spread(10, BurstPattern::SPREAD);
+    spread.setTarget(0.3F);
+
+    check(packet(spread, fired) == 3, "spread on cycles");
+    check(spread.getOnCycles() == 3, "spread getOnCycles");
+
+    for (uint8_t i = 1; i < 10; i++)
+        check(!(fired[i] && fired[i - 1]), "spread adjacent cycles");
+
+    // Block: 3 of 10 Cycles at the Start of the Packet.
+    BurstPattern block(10, BurstPattern::BLOCK);
+    block.setTarget(0.3F);
+
+    check(packet(block, fired) == 3, "block on cycles");
+    check(fired[0] && fired[1] && fired[2] && !fired[3] && !fired[9], "block at packet start");
+
+    // Target is taken over with the next Packet only.
+    block.setTarget(0.7F);
+
+    check(packet(block, nullptr) == 7, "block next target");
+}
+
+/**
+ * @brief Checks that the rounding residual is carried over to the next packets.
+ */
+void testResidual()
+{
+    BurstPattern pattern(50, BurstPattern::SPREAD);
+    pattern.setTarget(0.01F);
+
+    // 0.5 Cycles per Packet: one on Cycle every second Packet.
+    uint16_t total = 0;
+
+    for (uint8_t i = 0; i < 10; i++)
+    {
+        uint16_t count = packet(pattern, nullptr);
+
+        check(count <= 1, "residual on cycles per packet");
+
+        total += count;
+    }
+
+    check(total == 5, "residual mean");
+
+    // 2.5 Cycles per Packet: 5 on Cycles every two Packets.
+    pattern.setTarget(0.05F);
+
+    uint16_t first = packet(pattern, nullptr);
+    uint16_t second = packet(pattern, nullptr);
+
+    check(first + second == 5, "residual pair");
+}
+
+/**
+ * @brief Checks the limits of the target (0, 1 and beyond).
+ */
+void testLimits()
+{
+    BurstPattern spread(20, BurstPattern::SPREAD);
+    BurstPattern block(20, BurstPattern::BLOCK);
+
+    spread.setTarget(0);
+    block.setTarget(0);
+
+    check(packet(spread, nullptr) == 0, "spread target 0");
+    check(packet(block, nullptr) == 0, "block target 0");
+
+    spread.setTarget(1);
+    block.setTarget(1);
+
+    check(packet(spread, nullptr) == 20, "spread target 1");
+    check(packet(block, nullptr) == 20, "block target 1");
+
+    spread.setTarget(2);
+    block.setTarget(-1);
+
+    check(packet(spread, nullptr) == 20, "spread target above 1");
+    check(packet(block, nullptr) == 0, "block target below 0");
+}
+
+/**
+ * @brief Checks that reset() drops the residual and restarts the packet.
+ */
+void testReset()
+{
+    BurstPattern pattern(50, BurstPattern::BLOCK);
+    pattern.setTarget(0.01F);
+
+    // First Packet fires its Cycle and leaves a negative Residual.
+    check(packet(pattern, nullptr) == 1, "reset first packet");
+
+    // Without Reset the next Packet would be empty.
+    pattern.reset();
+
+    check(packet(pattern, nullptr) == 1, "reset drops residual");
+
+    // Reset inside a Packet starts a new one with the next Cycle.
+    pattern.setTarget(0.5F);
+    pattern.next();
+    pattern.reset();
+
+    check(packet(pattern, nullptr) == 25, "reset restarts packet");
+}
+
+/**
+ * @brief Runs all checks.
+ *
+ * @return 0 if all checks passed, otherwise 1.
+ */
+int main()
+{
+    testPacket();
+    testResidual();
+    testLimits();
+    testReset();
+
+    if (failures > 0)
+    {
+        fprintf(stderr, "%d checks failed\n", failures);
+
+        return 1;
+    }
+
+    printf("All checks passed\n");
+
+    return 0;
+}
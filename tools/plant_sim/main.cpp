@@ -0,0 +1,168 @@
+//
+// Created by JanHe on 16.10.2026.
+//
+
+// Closed loop benchmark of the unmodified Watcher against the Plant model.
+//
+// Usage: plant_sim [--profile clouds|clear|steps] [--seed N] [--start H] [--hours H]
+//                  [--mode dynamic|consume] [--consume kWh] [--pv W] [--load W] [--tank C]
+//                  [--rtu-latency ms] [--house-interval ms] [--house-latency ms] [--meter-window ms]
+//                  [--step ms] [--csv file] [--verbose]
+
+#include <Arduino.h>
+
+#include <cstring>
+
+#include "Benchmark.h"
+#include "PinOut.h"
+#include "Plant.h"
+#include "PlantLink.h"
+#include "Simulation.h"
+#include "Watcher.h"
+
+// Defined by the Fakes.
+extern bool simVerbose;
+
+// Band around the Setpoint and Threshold of a Disturbance in W.
+#define SIM_BAND 100.0F
+#define SIM_THRESHOLD 300.0F
+
+// Time the House Power must stay settled in ms.
+#define SIM_HOLD 5000
+
+// Interval of the CSV Trace in ms.
+#define SIM_TRACE 1000
+
+
+/**
+ * @brief Prints the usage and exits.
+ *
+ * @param name The name of the program.
+ */
+void usage(const char* name)
+{
+    fprintf(stderr, "Usage: %s [--profile clouds|clear|steps] [--seed N] [--start H] [--hours H]\n"
+            "       [--mode dynamic|consume] [--consume kWh] [--pv W] [--load W] [--tank C]\n"
+            "       [--rtu-latency ms] [--house-interval ms] [--house-latency ms] [--meter-window ms]\n"
+            "       [--step ms] [--csv file] [--verbose]\n", name);
+
+    exit(2);
+}
+
+int main(int argc, char** argv)
+{
+    Plant::Config config;
+    PlantLink::Meters meters;
+    Watcher::ModeType mode = Watcher::DYNAMIC;
+    float consume = 2.0F;
+    unsigned long step = 10;
+    const char* csv = nullptr;
+
+    for (int i = 1; i < argc; i++)
+    {
+        const char* arg = argv[i];
+
+        if (strcmp(arg, "--verbose") == 0)
+        {
+            simVerbose = true;
+            continue;
+        }
+
+        if (i + 1 >= argc)
+            usage(argv[0]);
+
+        const char* value = argv[++i];
+
+        if (strcmp(arg, "--profile") == 0)
+            config.profile = value;
+        else if (strcmp(arg, "--seed") == 0)
+            config.seed = strtoul(value, nullptr, 10);
+        else if (strcmp(arg, "--start") == 0)
+            config.start = atof(value);
+        else if (strcmp(arg, "--hours") == 0)
+            config.hours = atof(value);
+        else if (strcmp(arg, "--mode") == 0)
+            mode = (strcmp(value, "consume") == 0 ? Watcher::CONSUME : Watcher::DYNAMIC);
+        else if (strcmp(arg, "--consume") == 0)
+            consume = atof(value);
+        else if (strcmp(arg, "--pv") == 0)
+            config.pvPeak = atof(value);
+        else if (strcmp(arg, "--load") == 0)
+            config.baseLoad = atof(value);
+        else if (strcmp(arg, "--tank") == 0)
+            config.tankStart = atof(value);
+        else if (strcmp(arg, "--rtu-latency") == 0)
+            meters.rtuLatency = strtoul(value, nullptr, 10);
+        else if (strcmp(arg, "--house-interval") == 0)
+            meters.houseInterval = strtoul(value, nullptr, 10);
+        else if (strcmp(arg, "--house-latency") == 0)
+            meters.houseLatency = strtoul(value, nullptr, 10);
+        else if (strcmp(arg, "--meter-window") == 0)
+            meters.window = strtoul(value, nullptr, 10);
+        else if (strcmp(arg, "--step") == 0)
+            step = std::max(1UL, strtoul(value, nullptr, 10));
+        else if (strcmp(arg, "--csv") == 0)
+            csv = value;
+        else
+            usage(argv[0]);
+    }
+
+    Plant plant(config);
+    PlantLink link(plant, meters);
+    Benchmark benchmark(CONTROL_SETPOINT, SIM_BAND, SIM_THRESHOLD, SIM_HOLD);
+    FILE* trace = nullptr;
+
+    if (csv != nullptr)
+    {
+        trace = fopen(csv, "w");
+
+        if (trace == nullptr)
+        {
+            perror(csv);
+
+            return 1;
+        }
+
+        fprintf(trace, "time,pv,load,heater,house,duty,scr,pump,tank,outlet,measured,templock\n");
+    }
+
+    // Start like a booted ESP.
+    Simulation::begin(&link, 1000);
+
+    // Start like main.cpp of the Firmware.
+    Watcher::setupPins();
+    Watcher::setup();
+    Watcher::setMode(mode);
+
+    if (mode == Watcher::CONSUME)
+        Watcher::setMaxConsume(consume);
+
+    Watcher::setStandby(false);
+
+    unsigned long end = Simulation::now() + static_cast<unsigned long>(config.hours * 3600000.0);
+    unsigned long lastTrace = 0;
+
+    while (Simulation::now() < end)
+    {
+        Simulation::advance(step);
+        Watcher::loop();
+
+        benchmark.update(plant, Simulation::now(), step);
+
+        if (trace != nullptr && Simulation::now() - lastTrace >= SIM_TRACE)
+        {
+            lastTrace = Simulation::now();
+            benchmark.trace(trace, plant, lastTrace);
+        }
+    }
+
+    if (trace != nullptr)
+        fclose(trace);
+
+    printf("Profile %s, seed %u, %.2f h from %.2f h, %s mode\n", config.profile.c_str(), config.seed,
+           config.hours, config.start, mode == Watcher::DYNAMIC ? "dynamic" : "consume");
+
+    benchmark.print(Simulation::getSCRToggles(), Simulation::getPumpToggles(), Simulation::getDutyChanges());
+
+    return 0;
+}
@@ -0,0 +1,207 @@
+//
+// Created by JanHe on 16.10.2026.
+//
+
+// Deterministic replay of a field capture (see Recorder) against the unmodified Watcher.
+//
+// Usage: replay <log> [--step ms] [--tolerance ms] [--duty-tolerance N] [--csv file] [--verbose]
+//
+// Exits with 1 if the replayed decisions diverge from the field, so it can drive a
+// "git bisect run" over control changes.
+
+#include <Arduino.h>
+
+#include <algorithm>
+#include <climits>
+#include <cstring>
+
+#include "Capture.h"
+#include "DecisionDiff.h"
+#include "PinOut.h"
+#include "Recorder.h"
+#include "ReplayLink.h"
+#include "Simulation.h"
+#include "Watcher.h"
+
+// Defined by the Fakes.
+extern bool simVerbose;
+
+// Names of the Outputs (see Recorder::Output).
+const char* const REPLAY_OUTPUTS[] = {"duty", "scr", "pump"};
+
+
+/**
+ * @brief Prints the usage and exits.
+ *
+ * @param name The name of the program.
+ */
+void usage(const char* name)
+{
+    fprintf(stderr, "Usage: %s <log> [--step ms] [--tolerance ms] [--duty-tolerance N] [--csv file] [--verbose]\n",
+            name);
+
+    exit(2);
+}
+
+/**
+ * @brief Reads the current outputs of the firmware.
+ *
+ * @param outputs The values by Recorder::Output.
+ */
+void readOutputs(float outputs[3])
+{
+    outputs[Recorder::DUTY] = Simulation::getDuty();
+    outputs[Recorder::SCR] = Simulation::isSCR();
+    outputs[Recorder::PUMP] = Simulation::isPump();
+}
+
+int main(int argc, char** argv)
+{
+    const char* path = nullptr;
+    const char* csv = nullptr;
+    unsigned long step = 5;
+    unsigned long tolerance = 1000;
+    float dutyTolerance = SCR_PWM_STEP;
+
+    for (int i = 1; i < argc; i++)
+    {
+        const char* arg = argv[i];
+
+        if (strcmp(arg, "--verbose") == 0)
+        {
+            simVerbose = true;
+            continue;
+        }
+
+        if (strncmp(arg, "--", 2) != 0)
+        {
+            path = arg;
+            continue;
+        }
+
+        if (i + 1 >= argc)
+            usage(argv[0]);
+
+        const char* value = argv[++i];
+
+        if (strcmp(arg, "--step") == 0)
+            step = std::max(1UL, strtoul(value, nullptr, 10));
+        else if (strcmp(arg, "--tolerance") == 0)
+            tolerance = strtoul(value, nullptr, 10);
+        else if (strcmp(arg, "--duty-tolerance") == 0)
+            dutyTolerance = atof(value);
+        else if (strcmp(arg, "--csv") == 0)
+            csv = value;
+        else
+            usage(argv[0]);
+    }
+
+    if (path == nullptr)
+        usage(argv[0]);
+
+    Capture capture;
+
+    if (!capture.load(path))
+    {
+        fprintf(stderr, "%s: no capture lines (build the firmware with CAPTURE 1)\n", path);
+
+        return 2;
+    }
+
+    ReplayLink link(capture);
+    DecisionDiff diff(tolerance, dutyTolerance);
+    unsigned long start = link.getStart();
+    unsigned long end = capture.getEnd();
+
+    for (const Capture::Line& line : capture.getOutputs())
+        diff.addField(Capture::outputOf(line.kind), line.time, line.value);
+
+    // Boot just before the first Input like the Field Device.
+    Simulation::begin(&link, start > 0 ? start - 1 : 0);
+
+    Watcher::setupPins();
+    Watcher::setup();
+
+    float last[3];
+    readOutputs(last);
+
+    for (int i = Recorder::DUTY; i <= Recorder::PUMP; i++)
+        diff.addReplay(i, Simulation::now(), last[i]);
+
+    FILE* trace = nullptr;
+
+    if (csv != nullptr)
+    {
+        trace = fopen(csv, "w");
+
+        if (trace == nullptr)
+        {
+            perror(csv);
+
+            return 2;
+        }
+
+        fprintf(trace, "time,source,output,value\n");
+
+        for (const Capture::Line& line : capture.getOutputs())
+        {
+            if (line.time >= start)
+                fprintf(trace, "%lu,field,%s,%.0f\n", line.time, line.kind.c_str(), line.value);
+        }
+    }
+
+    while (Simulation::now() < end)
+    {
+        // Step to the next Input, but never further than the Loop Interval.
+        unsigned long next = std::min(link.getNext(), end);
+        unsigned long dt = (next > Simulation::now() ? std::min(step, next - Simulation::now()) : 1);
+
+        Simulation::advance(dt);
+        Watcher::loop();
+
+        float outputs[3];
+        readOutputs(outputs);
+
+        for (int i = Recorder::DUTY; i <= Recorder::PUMP; i++)
+        {
+            if (outputs[i] == last[i])
+                continue;
+
+            last[i] = outputs[i];
+            diff.addReplay(i, Simulation::now(), outputs[i]);
+
+            if (trace != nullptr)
+                fprintf(trace, "%lu,replay,%s,%.0f\n", Simulation::now(), REPLAY_OUTPUTS[i], outputs[i]);
+        }
+    }
+
+    if (trace != nullptr)
+        fclose(trace);
+
+    printf("Replayed %.1f s from %.3f s, %u inputs\n", (end - start) / 1000.0, start / 1000.0, link.getApplied());
+
+    for (const std::string& kind : link.getUnknown())
+        printf("Unknown kind       %s\n", kind.c_str());
+
+    bool diverged = false;
+
+    for (int i = Recorder::DUTY; i <= Recorder::PUMP; i++)
+    {
+        DecisionDiff::Result result = diff.compare(i, start, end);
+
+        printf("%-5s changes %6u field %6u replay, %4u divergences, %8.1f s diverged", REPLAY_OUTPUTS[i],
+               result.fieldChanges, result.replayChanges, result.divergences, result.diverged / 1000.0);
+
+        if (result.divergences > 0)
+        {
+            printf(", first at %.3f s (field %.0f, replay %.0f)", result.first / 1000.0, result.fieldValue,
+                   result.replayValue);
+
+            diverged = true;
+        }
+
+        printf("\n");
+    }
+
+    return diverged ? 1 : 0;
+}
@@ -0,0 +1,89 @@
+//
+// Created by JanHe on 16.10.2026.
+//
+
+#ifndef SIM_ARDUINO_H
+#define SIM_ARDUINO_H
+
+// Host replacement of the Arduino core, the Plant Simulator implements the IO Functions.
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+
+using std::max;
+using std::min;
+
+typedef uint8_t u_int8_t;
+typedef uint32_t u_int32_t;
+
+#define OUTPUT 1
+#define INPUT 0
+#define LOW 0
+#define HIGH 1
+#define DEC 10
+#define HEX 16
+
+#define constrain(amt, low, high) ((amt) < (low) ? (low) : ((amt) > (high) ? (high) : (amt)))
+#define lowByte(w) ((uint8_t) ((w) & 0xff))
+#define highByte(w) ((uint8_t) ((w) >> 8))
+
+// Single Threaded Host, Critical Sections are not needed.
+typedef int portMUX_TYPE;
+#define portMUX_INITIALIZER_UNLOCKED 0
+#define portENTER_CRITICAL(x) (void)(x)
+#define portEXIT_CRITICAL(x) (void)(x)
+
+unsigned long millis();
+unsigned long micros();
+void delay(unsigned long ms);
+void pinMode(uint8_t pin, uint8_t mode);
+void digitalWrite(uint8_t pin, uint8_t value);
+int digitalRead(uint8_t pin);
+bool ledcAttach(uint8_t pin, uint32_t frequency, uint8_t resolution);
+bool ledcWrite(uint8_t pin, uint32_t duty);
+
+class String
+{
+public:
+    String(const char* text = "") : text(text) {}
+    String(int value) : text(std::to_string(value)) {}
+    String(long value) : text(std::to_string(value)) {}
+    String(unsigned int value) : text(std::to_string(value)) {}
+    String(unsigned long value) : text(std::to_string(value)) {}
+
+    String(float value, int decimals = 2)
+    {
+        char buffer[32];
+        snprintf(buffer, sizeof(buffer), "%.*f", decimals, value);
+        text = buffer;
+    }
+
+    void concat(const String& other) { text += other.text; }
+    const char* c_str() const { return text.c_str(); }
+    String operator+(const String& other) const { return String((text + other.text).c_str()); }
+    friend String operator+(const char* left, const String& right) { return String(left) + right; }
+
+private:
+    std::string text;
+};
+
+class SimSerial
+{
+public:
+    template <class T>
+    void print(T, int = 0) {}
+
+    template <class T>
+    void println(T, int = 0) {}
+
+    void println() {}
+};
+
+extern SimSerial Serial;
+
+#endif //SIM_ARDUINO_H
@@ -0,0 +1,28 @@
+//
+// Created by JanHe on 16.10.2026.
+//
+
+#ifndef SIM_DALLASTEMPERATURE_H
+#define SIM_DALLASTEMPERATURE_H
+
+#include "OneWire.h"
+
+typedef uint8_t DeviceAddress[8];
+
+// Temperature of the simulated Sensor (0 = Tank/Inlet, 1 = Outlet).
+float simTemperature(int index);
+
+class DallasTemperature
+{
+public:
+    explicit DallasTemperature(OneWire*) {}
+    void begin() {}
+    void setResolution(uint8_t) {}
+    void setWaitForConversion(bool) {}
+    void requestTemperatures() {}
+    uint8_t getDeviceCount() { return 2; }
+    bool getAddress(uint8_t* address, uint8_t index) { memset(address, index + 1, 8); return true; }
+    float getTempCByIndex(uint8_t index) { return simTemperature(index); }
+};
+
+#endif //SIM_DALLASTEMPERATURE_H
@@ -0,0 +1,12 @@
+//
+// Created by JanHe on 16.10.2026.
+//
+
+#ifndef SIM_ETHERNET_H
+#define SIM_ETHERNET_H
+
+class NetworkClient
+{
+};
+
+#endif //SIM_ETHERNET_H
@@ -0,0 +1,25 @@
+//
+// Created by JanHe on 16.10.2026.
+//
+
+#ifndef SIM_FLOWSENSOR_H
+#define SIM_FLOWSENSOR_H
+
+#include <Arduino.h>
+
+#define YFB5 0
+
+// Flow of the simulated Pump in l/min.
+float simFlowRate();
+
+class FlowSensor
+{
+public:
+    FlowSensor(uint8_t, uint8_t) {}
+    void begin(void (*)()) {}
+    void count() {}
+    void read() {}
+    float getFlowRate_m() { return simFlowRate(); }
+};
+
+#endif //SIM_FLOWSENSOR_H
@@ -0,0 +1,16 @@
+//
+// Created by JanHe on 16.10.2026.
+//
+
+#ifndef SIM_HARDWARESERIAL_H
+#define SIM_HARDWARESERIAL_H
+
+#include <Arduino.h>
+
+class HardwareSerial
+{
+public:
+    explicit HardwareSerial(int = 0) {}
+};
+
+#endif //SIM_HARDWARESERIAL_H
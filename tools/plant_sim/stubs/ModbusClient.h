@@ -0,0 +1,14 @@
+//
+// Created by JanHe on 16.10.2026.
+//
+
+#ifndef SIM_MODBUSCLIENT_H
+#define SIM_MODBUSCLIENT_H
+
+#include "ModbusMessage.h"
+
+class ModbusClient
+{
+};
+
+#endif //SIM_MODBUSCLIENT_H
@@ -0,0 +1,15 @@
+//
+// Created by JanHe on 16.10.2026.
+//
+
+#ifndef SIM_MODBUSCLIENTRTU_H
+#define SIM_MODBUSCLIENTRTU_H
+
+#include "HardwareSerial.h"
+#include "ModbusClient.h"
+
+class ModbusClientRTU : public ModbusClient
+{
+};
+
+#endif //SIM_MODBUSCLIENTRTU_H
@@ -0,0 +1,14 @@
+//
+// Created by JanHe on 16.10.2026.
+//
+
+#ifndef SIM_MODBUSCLIENTTCPASYNC_H
+#define SIM_MODBUSCLIENTTCPASYNC_H
+
+#include "ModbusClient.h"
+
+class ModbusClientTCPasync : public ModbusClient
+{
+};
+
+#endif //SIM_MODBUSCLIENTTCPASYNC_H
@@ -0,0 +1,24 @@
+//
+// Created by JanHe on 16.10.2026.
+//
+
+#ifndef SIM_MODBUSMESSAGE_H
+#define SIM_MODBUSMESSAGE_H
+
+#include <Arduino.h>
+
+enum Error : uint8_t
+{
+    SUCCESS = 0x00,
+    TIMEOUT = 0xE0,
+    CRC_ERROR = 0xE2,
+    IP_CONNECTION_FAILED = 0xE7,
+    REQUEST_QUEUE_FULL = 0xE8,
+    UNDEFINED_ERROR = 0xFF
+};
+
+class ModbusMessage
+{
+};
+
+#endif //SIM_MODBUSMESSAGE_H
@@ -0,0 +1,54 @@
+//
+// Created by JanHe on 16.10.2026.
+//
+
+#ifndef SIM_ONEBUTTON_H
+#define SIM_ONEBUTTON_H
+
+/**
+ * @class OneButton
+ * @brief Host replacement of the button library, presses are injected by simPress().
+ */
+class OneButton
+{
+public:
+    enum Event
+    {
+        CLICK, DOUBLE_CLICK, LONG_PRESS, EVENTS
+    };
+
+    OneButton(int pin, bool activeLow) : pin(pin)
+    {
+        next = first();
+        first() = this;
+    }
+
+    void attachClick(void (*callback)()) { callbacks[CLICK] = callback; }
+    void attachDoubleClick(void (*callback)()) { callbacks[DOUBLE_CLICK] = callback; }
+    void attachLongPressStart(void (*callback)()) { callbacks[LONG_PRESS] = callback; }
+    void tick() {}
+
+    // Invokes the Callback of a Button Event.
+    static void simPress(int pin, Event event)
+    {
+        for (OneButton* button = first(); button != nullptr; button = button->next)
+        {
+            if (button->pin == pin && button->callbacks[event] != nullptr)
+                button->callbacks[event]();
+        }
+    }
+
+private:
+    static OneButton*& first()
+    {
+        static OneButton* buttons = nullptr;
+
+        return buttons;
+    }
+
+    int pin;
+    OneButton* next;
+    void (*callbacks[EVENTS])() = {};
+};
+
+#endif //SIM_ONEBUTTON_H
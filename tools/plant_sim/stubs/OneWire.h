@@ -0,0 +1,16 @@
+//
+// Created by JanHe on 16.10.2026.
+//
+
+#ifndef SIM_ONEWIRE_H
+#define SIM_ONEWIRE_H
+
+#include <Arduino.h>
+
+class OneWire
+{
+public:
+    explicit OneWire(uint8_t) {}
+};
+
+#endif //SIM_ONEWIRE_H
@@ -0,0 +1,23 @@
+//
+// Created by JanHe on 16.10.2026.
+//
+
+#ifndef SIM_PREFERENCES_H
+#define SIM_PREFERENCES_H
+
+#include <Arduino.h>
+
+// NVS without Persistence, every Run starts blank.
+class Preferences
+{
+public:
+    bool begin(const char*, bool) { return true; }
+    void end() {}
+    size_t getBytesLength(const char*) { return 0; }
+    size_t getBytes(const char*, void*, size_t) { return 0; }
+    size_t putBytes(const char*, const void*, size_t length) { return length; }
+    uint8_t getUChar(const char*, uint8_t value) { return value; }
+    size_t putUChar(const char*, uint8_t) { return 1; }
+};
+
+#endif //SIM_PREFERENCES_H
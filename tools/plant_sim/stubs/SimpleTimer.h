@@ -0,0 +1,22 @@
+//
+// Created by JanHe on 16.10.2026.
+//
+
+#ifndef SIM_SIMPLETIMER_H
+#define SIM_SIMPLETIMER_H
+
+#include <Arduino.h>
+
+class SimpleTimer
+{
+public:
+    explicit SimpleTimer(unsigned long interval) : interval(interval) {}
+    bool isReady() { return millis() - start >= interval; }
+    void reset() { start = millis(); }
+
+private:
+    unsigned long interval;
+    unsigned long start = 0;
+};
+
+#endif //SIM_SIMPLETIMER_H
@@ -0,0 +1,8 @@
+//
+// Created by JanHe on 16.10.2026.
+//
+
+#ifndef SIM_WEBSERIAL_H
+#define SIM_WEBSERIAL_H
+
+#endif //SIM_WEBSERIAL_H
@@ -0,0 +1,13 @@
+//
+// Created by JanHe on 16.10.2026.
+//
+
+#ifndef SIM_HAHVAC_H
+#define SIM_HAHVAC_H
+
+// Only included by HomeAssistant.h, which the Simulator does not call into.
+class HAHVAC
+{
+};
+
+#endif //SIM_HAHVAC_H
@@ -0,0 +1,13 @@
+//
+// Created by JanHe on 16.10.2026.
+//
+
+#ifndef SIM_HASENSORNUMBER_H
+#define SIM_HASENSORNUMBER_H
+
+// Only included by HomeAssistant.h, which the Simulator does not call into.
+class HASensorNumber
+{
+};
+
+#endif //SIM_HASENSORNUMBER_H
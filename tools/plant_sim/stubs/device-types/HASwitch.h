@@ -0,0 +1,13 @@
+//
+// Created by JanHe on 16.10.2026.
+//
+
+#ifndef SIM_HASWITCH_H
+#define SIM_HASWITCH_H
+
+// Only included by HomeAssistant.h, which the Simulator does not call into.
+class HASwitch
+{
+};
+
+#endif //SIM_HASWITCH_H
@@ -0,0 +1,27 @@
+//
+// Created by JanHe on 16.10.2026.
+//
+
+#ifndef SIM_ESP_TIMER_H
+#define SIM_ESP_TIMER_H
+
+#include <Arduino.h>
+
+// Periodic Timers run as Tasks of the Simulation (see Fakes.cpp), the Period is rounded to ms.
+typedef int esp_err_t;
+typedef struct esp_timer* esp_timer_handle_t;
+typedef void (*esp_timer_cb_t)(void* arg);
+
+struct esp_timer_create_args_t
+{
+    esp_timer_cb_t callback;
+    void* arg;
+    int dispatch_method;
+    const char* name;
+    bool skip_unhandled_events;
+};
+
+esp_err_t esp_timer_create(const esp_timer_create_args_t* args, esp_timer_handle_t* handle);
+esp_err_t esp_timer_start_periodic(esp_timer_handle_t timer, uint64_t period);
+
+#endif //SIM_ESP_TIMER_H
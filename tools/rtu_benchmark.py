@@ -0,0 +1,144 @@
+#!/usr/bin/env python3
+# RTU turnaround benchmark based on the /modbus statistics endpoint.
+#
+# Records the RTU wire times of a running controller for a while and stores them
+# labelled with the RS485 mode ("gpio" or "uart", see MODBUS_RS485_HARDWARE in
+# PinOut.h). Flash both variants, record each, then compare both recordings.
+#
+# The wire time is measured in µs for transactions which were sent to an idle RTU
+# client, so it does not contain the wait behind other queued blocks like the RTT
+# (whole ms, log2 histogram). The min. is kept since boot, so restart the controller
+# before recording. The RTT values are recorded for reference only.
+#
+# Usage:
+#   python3 tools/rtu_benchmark.py record --host 192.168.1.72 --duration 300 --out gpio.json
+#   python3 tools/rtu_benchmark.py record --host 192.168.1.72 --duration 300 --out uart.json
+#   python3 tools/rtu_benchmark.py compare gpio.json uart.json
+
+import argparse
+import json
+import statistics
+import sys
+import time
+import urllib.request
+
+
+def fetch(host):
+    with urllib.request.urlopen("http://%s/modbus" % host, timeout=5) as response:
+        return json.load(response)
+
+
+def record(args):
+    samples = []
+    first = None
+    last = None
+    mode = None
+    end = time.monotonic() + args.duration
+
+    while time.monotonic() < end:
+        try:
+            stats = fetch(args.host)
+        except OSError as error:
+            print("fetch failed: %s" % error, file=sys.stderr)
+            time.sleep(args.interval)
+            continue
+
+        rtu = stats["rtu"]
+        mode = stats.get("rs485", "gpio")
+
+        rtu["wire"] = stats["wire"]
+
+        if first is None:
+            first = (time.monotonic(), rtu)
+
+        last = (time.monotonic(), rtu)
+
+        # Skip Samples before the first Response.
+        if rtu["srtt"] > 0:
+            samples.append({"srtt": rtu["srtt"], "p50": rtu["p50"], "p95": rtu["p95"], "p99": rtu["p99"]})
+
+        time.sleep(args.interval)
+
+    if first is None or not samples:
+        print("no samples recorded", file=sys.stderr)
+        return 1
+
+    elapsed = max(last[0] - first[0], 1e-3)
+    wires = last[1]["wire"]["count"] - first[1]["wire"]["count"]
+
+    if wires <= 0:
+        print("no wire times recorded", file=sys.stderr)
+        return 1
+
+    # Mean of the Recording from the cumulative Means of both Snapshots.
+    wire_sum = last[1]["wire"]["mean"] * last[1]["wire"]["count"] - first[1]["wire"]["mean"] * first[1]["wire"]["count"]
+
+    result = {
+        "mode": mode,
+        "duration": elapsed,
+        "responses": last[1]["responses"] - first[1]["responses"],
+        "transactions": (last[1]["responses"] - first[1]["responses"]) / elapsed,
+        "timeouts": last[1]["timeouts"] - first[1]["timeouts"],
+        "crc": last[1]["crc"] - first[1]["crc"],
+        "wires": wires,
+        "wire_mean": wire_sum / wires,
+        "wire_min": last[1]["wire"]["min"],
+        "wire_max": last[1]["wire"]["max"],
+        "srtt": statistics.median(s["srtt"] for s in samples),
+        "srtt_min": min(s["srtt"] for s in samples),
+        "p50": statistics.median(s["p50"] for s in samples),
+        "p95": statistics.median(s["p95"] for s in samples),
+        "p99": max(s["p99"] for s in samples),
+    }
+
+    print(json.dumps(result, indent=2))
+
+    if args.out:
+        with open(args.out, "w") as file:
+            json.dump(result, file, indent=2)
+
+    return 0
+
+
+def compare(args):
+    with open(args.first) as file:
+        a = json.load(file)
+
+    with open(args.second) as file:
+        b = json.load(file)
+
+    keys = ["transactions", "wire_mean", "wire_min", "wire_max", "srtt", "srtt_min", "p50", "p95", "p99", "timeouts",
+            "crc"]
+
+    print("%-14s %12s %12s %12s" % ("", a["mode"], b["mode"], "delta"))
+
+    for key in keys:
+        delta = b[key] - a[key]
+        print("%-14s %12.2f %12.2f %+12.2f" % (key, a[key], b[key], delta))
+
+    return 0
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__)
+    commands = parser.add_subparsers(dest="command", required=True)
+
+    parser_record = commands.add_parser("record", help="record RTU statistics of a controller")
+    parser_record.add_argument("--host", required=True, help="address of the controller")
+    parser_record.add_argument("--duration", type=float, default=300, help="recording time in s")
+    parser_record.add_argument("--interval", type=float, default=1, help="poll interval in s")
+    parser_record.add_argument("--out", help="file to store the result")
+    parser_record.set_defaults(run=record)
+
+    parser_compare = commands.add_parser("compare", help="compare two recordings")
+    parser_compare.add_argument("first")
+    parser_compare.add_argument("second")
+    parser_compare.set_defaults(run=compare)
+
+    args = parser.parse_args()
+
+    return args.run(args)
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -0,0 +1,406 @@
+#!/usr/bin/env python3
+# Eastron SDM meter simulator for host-side benchmarking of LocalModbus.
+#
+# Serves the Eastron register map on two faces:
+# - Modbus RTU over a pseudo-terminal (the path of the slave end is printed on start)
+# - Modbus TCP on a local port (house meter, see MODBUS_TCP in PinOut.h)
+#
+# Usage:
+#   python3 tools/sdm_simulator.py --tcp-port 5020 --profile clouds --latency 40 --jitter 10
+#   python3 tools/sdm_simulator.py --profile profile.json --crc-error 0.02 --timeout 0.01
+#
+# A profile file is JSON with lists of [seconds, watts] points, which are linearly
+# interpolated (and repeated if "loop" is true):
+#   {"loop": true, "power": [[0, 0], [60, 6000]], "house": [[0, 500], [60, -2500]]}
+
+import argparse
+import json
+import math
+import os
+import random
+import select
+import socket
+import struct
+import sys
+import threading
+import time
+import tty
+
+# Register Map (keep in sync with src/MeterRegisters.h).
+PHASE_1_POWER = 0x000C
+PHASE_2_POWER = 0x000E
+PHASE_3_POWER = 0x0010
+POWER_USAGE = 0x0034
+POWER_IMPORT = 0x0048
+POWER_EXPORT = 0x004A
+
+# Holding Register of the Network Baud Rate (0=2400, 1=4800, 2=9600, 3=19200, 4=38400).
+BAUD_RATE = 0x001C
+
+# Modbus Function Codes.
+READ_HOLDING_REGISTER = 0x03
+READ_INPUT_REGISTER = 0x04
+WRITE_MULT_REGISTERS = 0x10
+
+# Modbus Exception Codes.
+ILLEGAL_FUNCTION = 0x01
+ILLEGAL_DATA_ADDRESS = 0x02
+
+# Eastron allows up to 80 Registers per Request.
+MAX_REGISTERS = 80
+
+
+def crc16(data):
+    """Modbus RTU CRC-16 (polynomial 0xA001), same as LocalModbus::calculateCRC()."""
+    crc = 0xFFFF
+    for byte in data:
+        crc ^= byte
+        for _ in range(8):
+            if crc & 1:
+                crc = (crc >> 1) ^ 0xA001
+            else:
+                crc >>= 1
+    return crc
+
+
+class Profile:
+    """Power profile as list of [seconds, watts] points or a built-in generator."""
+
+    def __init__(self, spec, key, seed):
+        self.points = None
+        self.loop = True
+        self.builtin = None
+        self.random = random.Random(seed)
+        self.walk = 0.0
+        self.last = 0.0
+
+        if spec.endswith(".json"):
+            with open(spec) as file:
+                data = json.load(file)
+            self.points = data.get(key, [[0, 0]])
+            self.loop = data.get("loop", True)
+        else:
+            self.builtin = spec
+
+    def value(self, t):
+        if self.points is not None:
+            return self.interpolate(t)
+
+        name, _, arg = self.builtin.partition(":")
+
+        if name == "constant":
+            return float(arg or 0)
+        if name == "sine":
+            # One Day in 10 Minutes.
+            return max(0.0, 6000.0 * math.sin(math.pi * (t % 600) / 600))
+        if name == "clouds":
+            # Random Walk with sudden Drops (Cloud Transients), seeded for Repeatability.
+            if t - self.last >= 0.1:
+                self.last = t
+                self.walk += self.random.uniform(-150, 150)
+                if self.random.random() < 0.01:
+                    self.walk -= self.random.uniform(1000, 3000)
+                self.walk = min(6000.0, max(0.0, self.walk + 20))
+            return self.walk
+
+        raise ValueError("Unknown profile " + self.builtin)
+
+    def interpolate(self, t):
+        points = self.points
+        end = points[-1][0]
+
+        if self.loop and end > 0:
+            t %= end
+
+        if t <= points[0][0]:
+            return float(points[0][1])
+
+        for (t0, v0), (t1, v1) in zip(points, points[1:]):
+            if t0 <= t <= t1:
+                return v0 + (v1 - v0) * (t - t0) / max(t1 - t0, 1e-9)
+
+        return float(points[-1][1])
+
+
+class Meter:
+    """Register Map of a single Eastron SDM meter."""
+
+    def __init__(self, name, profile):
+        self.name = name
+        self.profile = profile
+        self.start = time.monotonic()
+        self.updated = self.start
+        self.energy = 0.0
+        self.exported = 0.0
+        self.baud = 2
+        self.lock = threading.Lock()
+
+    def update(self):
+        now = time.monotonic()
+
+        with self.lock:
+            power = self.profile.value(now - self.start)
+
+            # Integrate positive Power into the Import and negative Power into the Export Counter (kWh).
+            self.energy += max(power, 0.0) * (now - self.updated) / 3600000.0
+            self.exported += max(-power, 0.0) * (now - self.updated) / 3600000.0
+            self.updated = now
+
+        return power
+
+    def input_registers(self, address, count):
+        power = self.update()
+        values = {POWER_USAGE: power, POWER_IMPORT: self.energy, POWER_EXPORT: self.exported,
+                  PHASE_1_POWER: power / 3, PHASE_2_POWER: power / 3, PHASE_3_POWER: power / 3}
+        words = []
+
+        for register in range(address, address + count):
+            base = register & ~1
+            value = values.get(base, 0.0)
+            high, low = struct.unpack(">HH", struct.pack(">f", value))
+            words.append(high if register == base else low)
+
+        return words
+
+    def holding_registers(self, address, count):
+        words = []
+
+        for register in range(address, address + count):
+            base = register & ~1
+            value = float(self.baud) if base == BAUD_RATE else 0.0
+            high, low = struct.unpack(">HH", struct.pack(">f", value))
+            words.append(high if register == base else low)
+
+        return words
+
+    def write_registers(self, address, words):
+        if address == BAUD_RATE and len(words) == 2:
+            self.baud = int(struct.unpack(">f", struct.pack(">HH", *words))[0])
+            print("%s: baud rate index set to %d" % (self.name, self.baud))
+
+
+class Stats:
+    """Request Counters of a single simulator face."""
+
+    def __init__(self, name):
+        self.name = name
+        self.requests = 0
+        self.answered = 0
+        self.corrupted = 0
+        self.dropped = 0
+        self.exceptions = 0
+        self.lock = threading.Lock()
+
+    def add(self, field):
+        with self.lock:
+            setattr(self, field, getattr(self, field) + 1)
+
+    def answer(self, pdu):
+        """Counts a sent response PDU, exception responses are not counted as answered."""
+        self.add("exceptions" if pdu[0] & 0x80 else "answered")
+
+    def line(self, elapsed):
+        with self.lock:
+            rate = self.requests / elapsed if elapsed > 0 else 0.0
+            return "%s: %d req (%.1f/s), %d ok, %d crc, %d timeout, %d exc" % (
+                self.name, self.requests, rate, self.answered, self.corrupted, self.dropped, self.exceptions)
+
+
+class Faults:
+    """Fault Injection (Latency, CRC Corruption and Timeouts)."""
+
+    def __init__(self, args):
+        self.latency = args.latency / 1000.0
+        self.jitter = args.jitter / 1000.0
+        self.crc_error = args.crc_error
+        self.timeout = args.timeout
+        self.random = random.Random(args.seed)
+
+    def delay(self):
+        time.sleep(max(0.0, self.latency + self.random.uniform(-self.jitter, self.jitter)))
+
+    def drop(self):
+        return self.random.random() < self.timeout
+
+    def corrupt(self):
+        return self.random.random() < self.crc_error
+
+
+def handle_pdu(meter, pdu):
+    """Processes a request PDU (function code + data) and returns the response PDU."""
+    function = pdu[0]
+
+    if function in (READ_INPUT_REGISTER, READ_HOLDING_REGISTER) and len(pdu) >= 5:
+        address, count = struct.unpack(">HH", pdu[1:5])
+
+        if count == 0 or count > MAX_REGISTERS:
+            return bytes([function | 0x80, ILLEGAL_DATA_ADDRESS])
+
+        if function == READ_INPUT_REGISTER:
+            words = meter.input_registers(address, count)
+        else:
+            words = meter.holding_registers(address, count)
+
+        return bytes([function, count * 2]) + struct.pack(">%dH" % count, *words)
+
+    if function == WRITE_MULT_REGISTERS and len(pdu) >= 6:
+        address, count, length = struct.unpack(">HHB", pdu[1:6])
+        words = struct.unpack(">%dH" % count, pdu[6:6 + length])
+        meter.write_registers(address, list(words))
+
+        return bytes([function]) + struct.pack(">HH", address, count)
+
+    return bytes([function | 0x80, ILLEGAL_FUNCTION])
+
+
+def serve_rtu(meter, server_id, faults, stats):
+    """Serves Modbus RTU over a pseudo-terminal until the process is stopped."""
+    master, slave = os.openpty()
+    tty.setraw(master)
+    print("RTU: serving server id %d on %s" % (server_id, os.ttyname(slave)))
+
+    buffer = b""
+
+    while True:
+        # Frames are separated by silence (3.5 chars at 9600 baud ~ 4 ms).
+        ready, _, _ = select.select([master], [], [], 0.004)
+
+        if ready:
+            buffer += os.read(master, 256)
+            continue
+
+        if not buffer:
+            continue
+
+        frame, buffer = buffer, b""
+
+        if len(frame) < 4 or crc16(frame[:-2]) != struct.unpack("<H", frame[-2:])[0]:
+            continue
+
+        # Ignore Requests for other Slaves (shared Bus).
+        if frame[0] != server_id:
+            continue
+
+        stats.add("requests")
+
+        if faults.drop():
+            stats.add("dropped")
+            continue
+
+        pdu = handle_pdu(meter, frame[1:-2])
+        response = bytes([server_id]) + pdu
+        crc = crc16(response)
+
+        if faults.corrupt():
+            crc ^= 0xFFFF
+            stats.add("corrupted")
+        else:
+            stats.answer(pdu)
+
+        faults.delay()
+        os.write(master, response + struct.pack("<H", crc))
+
+
+def serve_tcp_client(connection, meter, faults, stats):
+    """Serves a single Modbus TCP connection (pipelined requests are answered in order)."""
+    buffer = b""
+
+    with connection:
+        while True:
+            data = connection.recv(512)
+
+            if not data:
+                return
+
+            buffer += data
+
+            while len(buffer) >= 7:
+                transaction, protocol, length, unit = struct.unpack(">HHHB", buffer[:7])
+
+                if len(buffer) < 6 + length:
+                    break
+
+                pdu, buffer = buffer[7:6 + length], buffer[6 + length:]
+                stats.add("requests")
+
+                if faults.drop():
+                    stats.add("dropped")
+                    continue
+
+                response = handle_pdu(meter, pdu)
+                faults.delay()
+
+                # TCP has no CRC, a corrupted Frame is sent as broken Length instead.
+                if faults.corrupt():
+                    stats.add("corrupted")
+                    response = response[:-1]
+                else:
+                    stats.answer(response)
+
+                header = struct.pack(">HHHB", transaction, protocol, len(response) + 1, unit)
+                connection.sendall(header + response)
+
+
+def serve_tcp(meter, host, port, faults, stats):
+    """Accepts Modbus TCP connections until the process is stopped."""
+    server = socket.socket(socket.AF_INET, socket.SOCK_STREAM)
+    server.setsockopt(socket.SOL_SOCKET, socket.SO_REUSEADDR, 1)
+    server.bind((host, port))
+    server.listen(4)
+    print("TCP: serving house meter on %s:%d" % (host, port))
+
+    while True:
+        connection, _ = server.accept()
+        connection.setsockopt(socket.IPPROTO_TCP, socket.TCP_NODELAY, 1)
+        threading.Thread(target=serve_tcp_client, args=(connection, meter, faults, stats), daemon=True).start()
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Eastron SDM meter simulator (Modbus RTU + TCP)")
+    parser.add_argument("--profile", default="sine",
+                        help="profile of the heater meter: constant:<W>, sine, clouds or a .json file")
+    parser.add_argument("--house-profile", default=None,
+                        help="profile of the house meter (defaults to --profile, key 'house' for .json)")
+    parser.add_argument("--server-id", type=int, default=1, help="RTU server id (MODBUS_CORE)")
+    parser.add_argument("--tcp-host", default="127.0.0.1", help="bind address of the TCP face")
+    parser.add_argument("--tcp-port", type=int, default=5020, help="port of the TCP face (0 disables)")
+    parser.add_argument("--no-rtu", action="store_true", help="disable the RTU face")
+    parser.add_argument("--latency", type=float, default=20.0, help="response latency in ms")
+    parser.add_argument("--jitter", type=float, default=0.0, help="latency jitter in ms (+/-)")
+    parser.add_argument("--crc-error", type=float, default=0.0, help="probability of a corrupted response")
+    parser.add_argument("--timeout", type=float, default=0.0, help="probability of an unanswered request")
+    parser.add_argument("--seed", type=int, default=1, help="seed for profiles and fault injection")
+    parser.add_argument("--stats", type=float, default=5.0, help="statistics interval in s (0 disables)")
+    args = parser.parse_args()
+
+    faults = Faults(args)
+    started = time.monotonic()
+    faces = []
+
+    if not args.no_rtu:
+        meter = Meter("RTU", Profile(args.profile, "power", args.seed))
+        stats = Stats("RTU")
+        faces.append(stats)
+        threading.Thread(target=serve_rtu, args=(meter, args.server_id, faults, stats), daemon=True).start()
+
+    if args.tcp_port:
+        house = Meter("TCP", Profile(args.house_profile or args.profile, "house", args.seed + 1))
+        stats = Stats("TCP")
+        faces.append(stats)
+        threading.Thread(target=serve_tcp, args=(house, args.tcp_host, args.tcp_port, faults, stats),
+                         daemon=True).start()
+
+    try:
+        while True:
+            time.sleep(args.stats or 3600)
+
+            if args.stats:
+                for stats in faces:
+                    print(stats.line(time.monotonic() - started))
+                sys.stdout.flush()
+    except KeyboardInterrupt:
+        pass
+
+
+if __name__ == "__main__":
+    main()